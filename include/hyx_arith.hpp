@@ -0,0 +1,702 @@
+#pragma once
+
+#include <version>
+#if __cplusplus < 202302L
+#error "hyx_arith.hpp requires C++23 or later."
+#endif
+
+/**
+ * @file hyx_arith.hpp
+ * @brief 数论函数 (下标从 1 开始的 autoseq) 的组合与求值
+ * @note 第 0 项固定为 T{}，不参与运算。大整数处的单点求值基于 64 位 Montgomery 运算、
+ *       确定性 Miller-Rabin 与 Pollard-Brent rho 分解
+ *
+ * @version 1.0.0
+ * @author Heylyx841
+ * @date 2026-10-18
+ * @license MIT License
+ */
+
+#include "hyx_autoseq.hpp"
+#include "hyx_automemo.hpp"
+
+#include <vector>       // std::vector
+#include <span>         // std::span
+#include <utility>      // std::forward, std::move, std::pair
+#include <functional>   // std::invoke
+#include <algorithm>    // std::max, std::min, std::sort
+#include <numeric>      // std::gcd
+#include <cmath>        // std::sqrt
+#include <cstdint>      // std::uint32_t, std::uint64_t
+#include <cstddef>      // size_t
+#include <concepts>     // std::convertible_to
+#include <bit>          // std::countr_zero
+#include <type_traits>  // std::decay_t
+
+/**
+ * @namespace hyx
+ */
+namespace hyx
+{
+
+/**
+ * @namespace arith_details
+ * @brief 内部实现细节
+ */
+namespace arith_details
+{
+
+/** @brief floor(sqrt(n)) */
+[[nodiscard]] inline std::uint64_t isqrt(std::uint64_t n) noexcept
+{
+	auto r = static_cast<std::uint64_t>(std::sqrt(static_cast<double>(n)));
+	while(r > 0 && r > n / r) --r;
+	while((r + 1) <= n / (r + 1)) ++r;
+	return r;
+}
+
+/**
+ * @class PrimeTable
+ * @brief 按需扩展的小素数表，供分段筛使用
+ */
+class PrimeTable
+{
+public:
+	/** @brief 保证包含不超过 limit 的全部素数 */
+	void extend(std::uint64_t limit)
+	{
+		if(limit <= limit_) return;
+		limit = std::max<std::uint64_t>(limit, 2 * limit_);
+		std::vector<bool> composite(limit + 1, false);
+		primes_.clear();
+		for(std::uint64_t i = 2; i <= limit; ++i)
+		{
+			if(composite[i]) continue;
+			primes_.push_back(static_cast<std::uint32_t>(i));
+			for(std::uint64_t j = i * i; j <= limit; j += i)
+				composite[j] = true;
+		}
+		limit_ = limit;
+	}
+
+	[[nodiscard]] std::span<const std::uint32_t> primes() const noexcept
+	{
+		return primes_;
+	}
+
+private:
+	std::vector<std::uint32_t> primes_;
+	std::uint64_t limit_ = 1;
+};
+
+/**
+ * @brief 分段筛出 [lo, hi) 中每个数的最小素因子，素数 (及 0, 1) 处为 0
+ */
+inline void sieve_spf(size_t lo, size_t hi, PrimeTable& table, std::vector<std::uint32_t>& spf)
+{
+	spf.assign(hi - lo, 0);
+	if(hi < 4) return;
+	const std::uint64_t root = isqrt(hi - 1);
+	table.extend(root);
+	for(std::uint32_t p : table.primes())
+	{
+		if(p > root) break;
+		const std::uint64_t pp = std::uint64_t{p} * p;
+		std::uint64_t m = std::max<std::uint64_t>(pp, (lo + p - 1) / p * p);
+		for(; m < hi; m += p)
+		{
+			if(spf[m - lo] == 0) spf[m - lo] = p;
+		}
+	}
+}
+
+/**
+ * @brief 积性函数在 [lo, hi) 上的值，追加到 block
+ * @param at 已求出的值 (索引小于 n)
+ * @param pp 素数幂处的值 pp(p, e)，e >= 1
+ * @note 按 n = p^e * m 拆分 (p 为最小素因子)，m > 1 时 f(n) = f(p^e) f(m)
+ */
+template <typename T, typename At, typename PP>
+void multiplicative_block(size_t lo, size_t hi, const std::vector<std::uint32_t>& spf, std::vector<T>& block, At&& at, PP&& pp)
+{
+	for(size_t n = lo; n < hi; ++n)
+	{
+		if(n < 2)
+		{
+			block.push_back(n == 1 ? T(1) : T {});
+			continue;
+		}
+		const size_t p = spf[n - lo] ? spf[n - lo] : n;
+		size_t q = p, m = n / p;
+		unsigned e = 1;
+		while(m % p == 0)
+		{
+			m /= p;
+			q *= p;
+			++e;
+		}
+		block.push_back(m == 1 ? static_cast<T>(pp(p, e)) : static_cast<T>(at(q) * at(m)));
+	}
+}
+
+/**
+ * @class Multiplicative
+ * @brief 只在素数幂处给出的积性函数
+ */
+template <typename T, typename Fn>
+class Multiplicative
+{
+public:
+	explicit Multiplicative(Fn fn) : fn_(std::move(fn)) {}
+
+	/** @brief f(p^e)，f(1) = 1 */
+	[[nodiscard]] T at_prime_power(std::uint64_t p, unsigned e) const
+	{
+		return e == 0 ? T(1) : static_cast<T>(std::invoke(fn_, p, e));
+	}
+
+	/** @brief 前 hi 项 (按需用线性时间的分段筛补齐) */
+	[[nodiscard]] std::span<const T> upto(size_t hi, size_t block)
+	{
+		while(values_.size() < hi)
+		{
+			const size_t lo = values_.size();
+			const size_t end = std::min(hi, lo + block);
+			sieve_spf(lo, end, primes_, spf_);
+			multiplicative_block<T>(lo, end, spf_, values_,
+			                        [this](size_t i) -> const T& { return values_[i]; },
+			                        [this](std::uint64_t p, unsigned e) { return at_prime_power(p, e); });
+		}
+		return values_;
+	}
+
+private:
+	Fn fn_;
+	std::vector<T> values_;
+	std::vector<std::uint32_t> spf_;
+	PrimeTable primes_;
+};
+
+/** @brief 可以按前缀取出 span 的数列 (如 autoseq) */
+template <typename S, typename T>
+concept prefix_sequence = requires(const S& s, size_t n)
+{
+	{ s.slice(n, n) } -> std::convertible_to<std::span<const T>>;
+};
+
+/**
+ * @class SequenceSource
+ * @brief 引用一个 autoseq 作为卷积输入
+ */
+template <typename T, typename S>
+class SequenceSource
+{
+public:
+	explicit SequenceSource(const S& seq) noexcept : seq_(&seq) {}
+
+	[[nodiscard]] std::span<const T> upto(size_t hi, size_t) const
+	{
+		return seq_->slice(0, hi);
+	}
+
+private:
+	const S* seq_;
+};
+
+template <typename T>
+struct is_multiplicative : std::false_type {};
+template <typename T, typename Fn>
+struct is_multiplicative<Multiplicative<T, Fn>> : std::true_type {};
+
+/** @brief 卷积输入：Multiplicative 按值保存，数列按引用保存 */
+template <typename T, typename In>
+auto make_source(In&& in)
+{
+	if constexpr(is_multiplicative<std::decay_t<In>>::value)
+		return std::decay_t<In>(std::forward<In>(in));
+	else
+	{
+		static_assert(prefix_sequence<std::decay_t<In>, T>,
+		              "hyx::dirichlet_convolution: Input must be an autoseq or hyx::multiplicative<T>(fn).");
+		return SequenceSource<T, std::decay_t<In>>(in);
+	}
+}
+
+/**
+ * @class Montgomery
+ * @brief 奇模数 n < 2^64 下的 Montgomery 乘法，R = 2^64
+ */
+class Montgomery
+{
+public:
+	explicit constexpr Montgomery(std::uint64_t n) noexcept
+		: n_(n), inv_(inverse(n)), r2_(static_cast<std::uint64_t>(square_r(n)))
+	{
+	}
+
+	[[nodiscard]] constexpr std::uint64_t modulus() const noexcept
+	{
+		return n_;
+	}
+
+	/** @brief a -> aR mod n */
+	[[nodiscard]] constexpr std::uint64_t to(std::uint64_t a) const noexcept
+	{
+		return mul(a % n_, r2_);
+	}
+
+	/** @brief aR mod n -> a */
+	[[nodiscard]] constexpr std::uint64_t from(std::uint64_t a) const noexcept
+	{
+		return reduce(a);
+	}
+
+	/** @brief (aR)(bR) -> abR mod n */
+	[[nodiscard]] constexpr std::uint64_t mul(std::uint64_t a, std::uint64_t b) const noexcept
+	{
+		return reduce(static_cast<unsigned __int128>(a) * b);
+	}
+
+	[[nodiscard]] constexpr std::uint64_t add(std::uint64_t a, std::uint64_t b) const noexcept
+	{
+		return a >= n_ - b ? a - (n_ - b) : a + b;
+	}
+
+	[[nodiscard]] constexpr std::uint64_t pow(std::uint64_t a, std::uint64_t e) const noexcept
+	{
+		std::uint64_t r = to(1);
+		for(; e; e >>= 1, a = mul(a, a))
+		{
+			if(e & 1) r = mul(r, a);
+		}
+		return r;
+	}
+
+private:
+	std::uint64_t n_;
+	std::uint64_t inv_;
+	std::uint64_t r2_;
+
+	/** @brief n^-1 mod 2^64 (Newton 迭代，每步精度翻倍) */
+	[[nodiscard]] static constexpr std::uint64_t inverse(std::uint64_t n) noexcept
+	{
+		std::uint64_t x = n;
+		for(int i = 0; i < 5; ++i)
+			x *= 2 - n * x;
+		return x;
+	}
+
+	[[nodiscard]] static constexpr unsigned __int128 square_r(std::uint64_t n) noexcept
+	{
+		const unsigned __int128 r = static_cast<std::uint64_t>(-n) % n; // 2^64 mod n
+		return r * r % n;
+	}
+
+	/** @brief t R^-1 mod n：低 64 位恰好抵消，只需比较高位，对任意奇数 n 都不会溢出 */
+	[[nodiscard]] constexpr std::uint64_t reduce(unsigned __int128 t) const noexcept
+	{
+		const std::uint64_t m = static_cast<std::uint64_t>(t) * inv_;
+		const auto hi = static_cast<std::uint64_t>(t >> 64);
+		const auto mn = static_cast<std::uint64_t>((static_cast<unsigned __int128>(m) * n_) >> 64);
+		return hi >= mn ? hi - mn : hi + (n_ - mn);
+	}
+};
+
+/**
+ * @brief Pollard-Brent rho：返回奇合数 n 的一个非平凡因子
+ * @note 每 128 步才做一次 gcd，乘积在 Montgomery 表示下累积 (R 与 n 互素，不影响 gcd)
+ */
+[[nodiscard]] inline std::uint64_t pollard_brent(std::uint64_t n) noexcept
+{
+	constexpr std::uint64_t batch = 128;
+	const Montgomery m(n);
+	const auto diff = [](std::uint64_t a, std::uint64_t b) { return a > b ? a - b : b - a; };
+
+	for(std::uint64_t c = 1;; ++c)
+	{
+		const std::uint64_t cm = m.to(c);
+		const auto f = [&](std::uint64_t x) { return m.add(m.mul(x, x), cm); };
+
+		std::uint64_t x = 0, y = m.to(2), ys = 0, q = m.to(1), g = 1;
+		for(std::uint64_t r = 1; g == 1; r <<= 1)
+		{
+			x = y;
+			for(std::uint64_t i = 0; i < r; ++i)
+				y = f(y);
+			for(std::uint64_t k = 0; k < r && g == 1; k += batch)
+			{
+				ys = y;
+				for(std::uint64_t i = 0; i < std::min(batch, r - k); ++i)
+				{
+					y = f(y);
+					q = m.mul(q, diff(x, y));
+				}
+				g = std::gcd(q, n);
+			}
+		}
+		if(g == n)
+		{
+			// 批内越过了因子：从批首逐步回退
+			do
+			{
+				ys = f(ys);
+				g = std::gcd(diff(x, ys), n);
+			} while(g == 1);
+		}
+		if(g != n) return g;
+	}
+}
+
+/**
+ * @class SpfFormula
+ * @brief 最小素因子数列的批量公式：spf(0) = 0, spf(1) = 1
+ */
+class SpfFormula
+{
+public:
+	void operator()(size_t n, std::span<const std::uint32_t>, autoseq_details::TermSink<std::uint32_t>& sink)
+	{
+		const size_t hi = n + block;
+		sieve_spf(n, hi, primes_, spf_);
+		for(size_t i = n; i < hi; ++i)
+			sink.emit(spf_[i - n] ? spf_[i - n] : static_cast<std::uint32_t>(i));
+	}
+
+private:
+	static constexpr size_t block = size_t{1} << 15;
+
+	PrimeTable primes_;
+	std::vector<std::uint32_t> spf_;
+};
+
+} // namespace arith_details
+
+/**
+ * @brief 只在素数幂处给出的积性函数，作为 dirichlet_convolution 的输入
+ * @param fn T(std::uint64_t p, unsigned e)，返回 f(p^e) (e >= 1)
+ * @note 例如 Möbius 函数：hyx::multiplicative<int>([](auto, unsigned e) { return e == 1 ? -1 : 0; })
+ */
+template <typename T, typename Fn>
+[[nodiscard]] auto multiplicative(Fn&& fn)
+{
+	return arith_details::Multiplicative<T, std::decay_t<Fn>>(std::forward<Fn>(fn));
+}
+
+/**
+ * @class dirichlet_formula
+ * @brief Dirichlet 卷积 h = f * g 的 autoseq 公式，h(n) = Σ_{d | n} f(d) g(n / d)
+ * @note 按块生成：每块 [lo, hi) 用倍数枚举一次累加所有 d * k 落在块内的乘积，
+ *       以 min(d, k) <= sqrt(hi) 划分枚举顺序，单块代价为 O(B log hi + sqrt(hi))，累计 O(n log n)，
+ *       块长固定因而累加区常驻缓存。两个输入都是 multiplicative 时 h 也是积性的，
+ *       改用分段最小素因子筛逐项合成，累计 O(n log log n)
+ */
+template <typename T, typename FSource, typename GSource>
+class dirichlet_formula
+{
+public:
+	dirichlet_formula(FSource f, GSource g, size_t block)
+		: f_(std::move(f)), g_(std::move(g)), block_(std::max<size_t>(block, 64))
+	{
+	}
+
+	void operator()(size_t n, std::span<const T> history, autoseq_details::TermSink<T>& sink)
+	{
+		if(n == 0)
+		{
+			sink.emit(T {});
+			n = 1;
+		}
+		const size_t lo = n;
+		const size_t hi = lo + std::max<size_t>(block_, arith_details::isqrt(lo) + 1);
+
+		block_values_.clear();
+		block_values_.reserve(hi - lo);
+		if constexpr(both_multiplicative)
+		{
+			arith_details::sieve_spf(lo, hi, primes_, spf_);
+			arith_details::multiplicative_block<T>(lo, hi, spf_, block_values_,
+				[&](size_t i) -> const T& { return i < lo ? history[i] : block_values_[i - lo]; },
+				[this](std::uint64_t p, unsigned e)
+				{
+					T sum {};
+					for(unsigned i = 0; i <= e; ++i)
+						sum += f_.at_prime_power(p, i) * g_.at_prime_power(p, e - i);
+					return sum;
+				});
+		}
+		else
+		{
+			const std::span<const T> f = f_.upto(hi, block_);
+			const std::span<const T> g = g_.upto(hi, block_);
+			block_values_.assign(hi - lo, T {});
+			T* acc = block_values_.data() - lo;
+			// 有序对 (s, t) 中较小者 s <= sqrt(hi)；s * t 落在 [lo, hi) 的 t 是一段连续区间
+			for(size_t s = 1; s * s < hi; ++s)
+			{
+				const size_t t_end = (hi - 1) / s + 1;
+				size_t t = std::max(s, (lo + s - 1) / s);
+				if(t < t_end && t == s)
+				{
+					acc[s * s] += f[s] * g[s];
+					++t;
+				}
+				for(; t < t_end; ++t)
+					acc[s * t] += f[s] * g[t] + f[t] * g[s];
+			}
+		}
+		for(auto& v : block_values_)
+			sink.emit(std::move(v));
+	}
+
+private:
+	static constexpr bool both_multiplicative =
+		arith_details::is_multiplicative<FSource>::value && arith_details::is_multiplicative<GSource>::value;
+
+	FSource f_;
+	GSource g_;
+	size_t block_;
+	std::vector<T> block_values_;
+	std::vector<std::uint32_t> spf_;
+	arith_details::PrimeTable primes_;
+};
+
+/**
+ * @brief 构造 Dirichlet 卷积 f * g 的公式，直接交给 autoseq
+ * @param f, g autoseq (按引用保存，须比结果活得更久) 或 hyx::multiplicative<T>(fn)
+ * @param block 每块项数，默认使累加区落在 L2 缓存内
+ * @note hyx::autoseq<std::int64_t> sigma(hyx::dirichlet_convolution<std::int64_t>(id, one));
+ */
+template <typename T, typename F, typename G>
+[[nodiscard]] auto dirichlet_convolution(F&& f, G&& g, size_t block = size_t{1} << 15)
+{
+	auto fs = arith_details::make_source<T>(std::forward<F>(f));
+	auto gs = arith_details::make_source<T>(std::forward<G>(g));
+	return dirichlet_formula<T, decltype(fs), decltype(gs)>(std::move(fs), std::move(gs), block);
+}
+
+/** @brief 素因子分解：按素数升序排列的 (p, e) */
+using factorization = std::vector<std::pair<std::uint64_t, unsigned>>;
+
+/**
+ * @brief 确定性 Miller-Rabin，对全部 64 位整数准确
+ */
+[[nodiscard]] inline bool is_prime(std::uint64_t n) noexcept
+{
+	if(n < 2) return false;
+	for(std::uint64_t p : {2u, 3u, 5u, 7u, 11u, 13u, 17u, 19u, 23u, 29u, 31u, 37u})
+	{
+		if(n % p == 0) return n == p;
+	}
+	if(n < 37 * 37) return true;
+
+	const arith_details::Montgomery m(n);
+	const std::uint64_t one = m.to(1), minus_one = m.to(n - 1);
+	const int s = std::countr_zero(n - 1);
+	const std::uint64_t d = (n - 1) >> s;
+	// 这 7 个底对 2^64 以内的全部合数至少有一个见证
+	for(std::uint64_t a : {2ull, 325ull, 9375ull, 28178ull, 450775ull, 9780504ull, 1795265022ull})
+	{
+		if(a % n == 0) continue;
+		std::uint64_t x = m.pow(m.to(a), d);
+		if(x == one || x == minus_one) continue;
+		bool witness = true;
+		for(int i = 1; i < s && witness; ++i)
+		{
+			x = m.mul(x, x);
+			if(x == minus_one) witness = false;
+		}
+		if(witness) return false;
+	}
+	return true;
+}
+
+/** @brief Euler 函数 φ(n) */
+[[nodiscard]] inline std::uint64_t euler_phi(const factorization& f) noexcept
+{
+	std::uint64_t r = 1;
+	for(auto [p, e] : f)
+	{
+		r *= p - 1;
+		for(unsigned i = 1; i < e; ++i) r *= p;
+	}
+	return r;
+}
+
+/** @brief 因子和 σ(n)；n 超过约 2.5e18 时可能溢出 */
+[[nodiscard]] inline std::uint64_t divisor_sigma(const factorization& f) noexcept
+{
+	std::uint64_t r = 1;
+	for(auto [p, e] : f)
+	{
+		std::uint64_t sum = 1, power = 1;
+		for(unsigned i = 0; i < e; ++i)
+		{
+			power *= p;
+			sum += power;
+		}
+		r *= sum;
+	}
+	return r;
+}
+
+/** @brief Möbius 函数 μ(n) */
+[[nodiscard]] inline int mobius(const factorization& f) noexcept
+{
+	for(auto [p, e] : f)
+	{
+		if(e > 1) return 0;
+	}
+	return f.size() % 2 ? -1 : 1;
+}
+
+/**
+ * @class factorizer
+ * @brief 64 位整数分解器
+ * @note 小于 sieve_limit 的数直接查最小素因子 autoseq (按需分段筛出)；更大的数先试除小素数，
+ *       再以 Miller-Rabin 判定、Pollard-Brent 拆分，结果在有界记忆表中缓存。
+ *       与 autoseq 一样不是线程安全的
+ */
+class factorizer
+{
+public:
+	/**
+	 * @param sieve_limit 最小素因子表的上限 (按需扩展，最多占用 4 * sieve_limit 字节)
+	 * @param memo_capacity 缓存的大数分解个数
+	 */
+	explicit factorizer(std::uint64_t sieve_limit = std::uint64_t{1} << 20, size_t memo_capacity = size_t{1} << 12)
+		: limit_(std::max<std::uint64_t>(sieve_limit, trial_limit))
+		, spf_(arith_details::SpfFormula {})
+		, memo_(memo_capacity, [this](const std::uint64_t& n, const auto&) { return factor_large(n); })
+	{
+		for(std::uint32_t p = 2; p < trial_limit; ++p)
+		{
+			if(spf_[p] == p) small_primes_.push_back(p);
+		}
+	}
+
+	/** @brief 记忆表捕获了 this，禁止拷贝与移动 */
+	factorizer(const factorizer&) = delete;
+	factorizer& operator=(const factorizer&) = delete;
+
+	/** @brief 素因子分解，n < 2 时为空 */
+	[[nodiscard]] factorization factor(std::uint64_t n) const
+	{
+		if(n < limit_) return factor_small(n);
+		return memo_(n);
+	}
+
+	[[nodiscard]] std::uint64_t phi(std::uint64_t n) const
+	{
+		return n == 0 ? 0 : euler_phi(factor(n));
+	}
+
+	[[nodiscard]] std::uint64_t sigma(std::uint64_t n) const
+	{
+		return n == 0 ? 0 : divisor_sigma(factor(n));
+	}
+
+	[[nodiscard]] int mu(std::uint64_t n) const
+	{
+		return n == 0 ? 0 : mobius(factor(n));
+	}
+
+	/** @brief 最小素因子表 */
+	[[nodiscard]] const autoseq<std::uint32_t>& smallest_prime_factors() const noexcept
+	{
+		return spf_;
+	}
+
+	/** @brief 大数分解记忆表的命中统计 */
+	[[nodiscard]] const automemo_stats& memo_stats() const noexcept
+	{
+		return memo_.stats();
+	}
+
+private:
+	/** @brief 大数先试除到该界 */
+	static constexpr std::uint32_t trial_limit = 1024;
+
+	std::uint64_t limit_;
+	autoseq<std::uint32_t> spf_;
+	std::vector<std::uint32_t> small_primes_;
+	bounded_automemo<std::uint64_t, factorization> memo_;
+
+	[[nodiscard]] factorization factor_small(std::uint64_t n) const
+	{
+		factorization f;
+		while(n > 1)
+		{
+			const std::uint64_t p = spf_[static_cast<size_t>(n)];
+			unsigned e = 0;
+			for(; n % p == 0; n /= p) ++e;
+			f.emplace_back(p, e);
+		}
+		return f;
+	}
+
+	[[nodiscard]] factorization factor_large(std::uint64_t n) const
+	{
+		std::vector<std::uint64_t> primes;
+		for(std::uint32_t p : small_primes_)
+		{
+			if(std::uint64_t{p} * p > n) break;
+			for(; n % p == 0; n /= p) primes.push_back(p);
+		}
+
+		// 余下部分没有小于 trial_limit 的因子
+		std::vector<std::uint64_t> pending;
+		if(n > 1) pending.push_back(n);
+		while(!pending.empty())
+		{
+			const std::uint64_t m = pending.back();
+			pending.pop_back();
+			if(m < limit_)
+			{
+				for(auto [p, e] : factor_small(m))
+					primes.insert(primes.end(), e, p);
+			}
+			else if(is_prime(m))
+			{
+				primes.push_back(m);
+			}
+			else
+			{
+				const std::uint64_t d = arith_details::pollard_brent(m);
+				pending.push_back(d);
+				pending.push_back(m / d);
+			}
+		}
+
+		std::sort(primes.begin(), primes.end());
+		factorization f;
+		for(std::uint64_t p : primes)
+		{
+			if(!f.empty() && f.back().first == p)
+				++f.back().second;
+			else
+				f.emplace_back(p, 1u);
+		}
+		return f;
+	}
+};
+
+/**
+ * @brief 以 factorizer 单点求值的数论函数数列
+ * @param fn T(const factorization&)，如 hyx::euler_phi
+ * @note 公式与历史无关，数列已声明 history_free 并启用调优：顺序访问照常缓存前缀，
+ *       10^18 级的远距离访问只分解该点并稀疏缓存；稀疏缓存只保留最近访问的 4096 项，
+ *       长时间随机访问的内存占用有界。fz 必须比数列活得更久
+ */
+template <typename T, typename Fn>
+[[nodiscard]] autoseq<T> factorized_sequence(const factorizer& fz, Fn fn)
+{
+	autoseq<T> seq([&fz, fn = std::move(fn)](size_t n, std::span<const T>) -> T
+	{
+		return n == 0 ? T {} : static_cast<T>(std::invoke(fn, fz.factor(n)));
+	});
+	seq.set_caps({.history_free = true});
+	seq.enable_tuning();
+	return seq;
+}
+
+} // namespace hyx
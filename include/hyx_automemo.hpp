@@ -0,0 +1,607 @@
+#pragma once
+
+#include <version>
+#if __cplusplus < 202302L
+#error "hyx_automemo.hpp requires C++23 or later."
+#endif
+
+/**
+ * @file hyx_automemo.hpp
+ * @brief 稀疏键上的记忆化递归函数
+ * @note 适用于 f(n) = f(n / 2) + f(n / 3) 这类只会访问极少数键的递归，键空间可达 10^15 以上；
+ *       公式写法与 autoseq 一致，可以是原始参数形式，也可以通过上下文对象递归调用
+ *
+ * @version 1.0.0
+ * @author Heylyx841
+ * @date 2026-10-18
+ * @license MIT License
+ */
+
+#include <atomic>       // std::atomic
+#include <mutex>        // std::mutex, std::lock_guard
+#include <deque>        // std::deque
+#include <vector>       // std::vector
+#include <memory>       // std::unique_ptr, std::make_unique
+#include <optional>     // std::optional
+#include <functional>   // std::hash, std::equal_to, std::invoke, std::move_only_function
+#include <thread>       // std::thread::hardware_concurrency
+#include <bit>          // std::bit_ceil
+#include <algorithm>    // std::max
+#include <cstdint>      // std::uint8_t, std::uint64_t
+#include <cstddef>      // size_t
+#include <type_traits>  // std::is_invocable_r_v
+#include <stdexcept>    // std::logic_error
+
+/**
+ * @namespace hyx
+ */
+namespace hyx
+{
+
+/**
+ * @namespace automemo_details
+ * @brief 内部实现细节
+ */
+namespace automemo_details
+{
+
+/** @brief 打散用户哈希 (std::hash 对整数通常是恒等映射) */
+[[nodiscard]] constexpr size_t mix(size_t h) noexcept
+{
+	std::uint64_t x = h;
+	x ^= x >> 33;
+	x *= 0xff51afd7ed558ccdull;
+	x ^= x >> 33;
+	x *= 0xc4ceb9fe1a85ec53ull;
+	x ^= x >> 33;
+	return static_cast<size_t>(x);
+}
+
+/**
+ * @class MemoContext
+ * @brief 公式的上下文：当前键与递归调用入口
+ */
+template <typename Memo>
+class MemoContext
+{
+public:
+	using key_type = typename Memo::key_type;
+
+	constexpr MemoContext(const key_type& key, const Memo& memo) noexcept
+		: key_(key), memo_(memo) {}
+
+	/** @brief 当前正在计算的键 */
+	[[nodiscard]] constexpr const key_type& key() const noexcept
+	{
+		return key_;
+	}
+
+	/** @brief 递归求 f(k) */
+	[[nodiscard]] decltype(auto) operator()(const key_type& k) const
+	{
+		return memo_(k);
+	}
+
+	[[nodiscard]] decltype(auto) operator[](const key_type& k) const
+	{
+		return memo_(k);
+	}
+
+	/** @brief 所属的记忆化对象 */
+	[[nodiscard]] constexpr const Memo& memo() const noexcept
+	{
+		return memo_;
+	}
+
+private:
+	const key_type& key_;
+	const Memo& memo_;
+};
+
+/**
+ * @brief 公式签名适配，规则与 autoseq 的 make_dispatch 相同
+ * @note 公式会被多个线程同时调用，必须可以通过 const 引用调用 (不要写 mutable lambda)
+ */
+template <typename Memo, typename F>
+auto make_memo_dispatch(F&& f)
+{
+	using K = typename Memo::key_type;
+	using V = typename Memo::mapped_type;
+	using Context = MemoContext<Memo>;
+	// 以上下文为参数：此时 Memo 尚不完整，不能直接出现在 move_only_function 的签名里
+	using Formula = std::move_only_function<V(Context) const>;
+
+	// 模式 A: 原始模式 V(const K& key, const Memo& self)
+	if constexpr(std::is_invocable_r_v<V, const F&, const K&, const Memo&>)
+	{
+		return Formula([f = std::forward<F>(f)](Context ctx) -> V
+		{
+			return static_cast<V>(std::invoke(f, ctx.key(), ctx.memo()));
+		});
+	}
+	// 模式 B: 上下文模式 V(MemoContext)
+	else if constexpr(std::is_invocable_r_v<V, const F&, Context>)
+	{
+		return Formula([f = std::forward<F>(f)](Context ctx) -> V
+		{
+			return static_cast<V>(std::invoke(f, ctx));
+		});
+	}
+	else
+	{
+		static_assert(false, "hyx::automemo: Unrecognized formula signature. Expected a const-invocable "
+		                     "V(const K&, const Memo&) or V(MemoContext).");
+	}
+}
+
+} // namespace automemo_details
+
+/**
+ * @class concurrent_automemo
+ * @brief 多线程共享的记忆化函数
+ * @note 分片开放寻址表：命中只需无锁探测；未命中时在分片锁内登记占位节点，随后在锁外计算，
+ *       同一个键只会被一个线程计算，其余线程等待结果。返回的引用在对象存活期间一直有效。
+ *       公式抛出异常时键不会被缓存，下一个访问者重新计算
+ *
+ * @tparam K 键类型
+ * @tparam V 值类型
+ */
+template <typename K, typename V, typename Hash = std::hash<K>, typename KeyEqual = std::equal_to<K>>
+class concurrent_automemo
+{
+public:
+	using key_type = K;
+	using mapped_type = V;
+	using context = automemo_details::MemoContext<concurrent_automemo>;
+
+	/**
+	 * @param f V(const K&, const concurrent_automemo&) 或 V(context)
+	 * @param shards 分片数 (向上取 2 的幂)，0 表示按硬件线程数选择
+	 */
+	template <typename F>
+	explicit concurrent_automemo(F&& f, size_t shards = 0, const Hash& hash = Hash(), const KeyEqual& equal = KeyEqual())
+		: formula_(automemo_details::make_memo_dispatch<concurrent_automemo>(std::forward<F>(f)))
+		, hash_(hash)
+		, equal_(equal)
+	{
+		if(shards == 0) shards = 4 * std::max(1u, std::thread::hardware_concurrency());
+		shard_count_ = std::bit_ceil(std::max<size_t>(shards, 8));
+		shards_ = std::make_unique<Shard[]>(shard_count_);
+	}
+
+	/** @brief 返回的引用指向表内节点，禁止拷贝与移动 */
+	concurrent_automemo(const concurrent_automemo&) = delete;
+	concurrent_automemo& operator=(const concurrent_automemo&) = delete;
+
+	/**
+	 * @brief 求 f(key)，必要时计算并缓存
+	 * @note 可多线程并发调用；递归依赖不得成环
+	 */
+	[[nodiscard]] const V& operator()(const K& key) const
+	{
+		const size_t h = automemo_details::mix(hash_(key));
+		Shard& s = shard_of(h);
+		Node* node = probe(s.table.load(std::memory_order_acquire), h, key);
+		if(!node) [[unlikely]]
+			node = claim_slot(s, h, key);
+		return resolve(*node);
+	}
+
+	[[nodiscard]] const V& operator[](const K& key) const
+	{
+		return (*this)(key);
+	}
+
+	/**
+	 * @brief 只查不算
+	 * @return 已缓存时返回值的地址，否则为 nullptr
+	 */
+	[[nodiscard]] const V* find(const K& key) const noexcept
+	{
+		const size_t h = automemo_details::mix(hash_(key));
+		const Node* node = probe(shard_of(h).table.load(std::memory_order_acquire), h, key);
+		if(!node || node->state.load(std::memory_order_acquire) != ready) return nullptr;
+		return &*node->value;
+	}
+
+	/** @brief 已缓存的键数 */
+	[[nodiscard]] size_t size() const noexcept
+	{
+		size_t total = 0;
+		for(size_t i = 0; i < shard_count_; ++i)
+			total += shards_[i].ready.load(std::memory_order_relaxed);
+		return total;
+	}
+
+private:
+	static constexpr std::uint8_t unclaimed = 0;
+	static constexpr std::uint8_t computing = 1;
+	static constexpr std::uint8_t ready = 2;
+
+	/** @brief 每个分片的初始槽数 */
+	static constexpr size_t initial_slots = 16;
+
+	struct Node
+	{
+		size_t hash;
+		K key;
+		std::atomic<std::uint8_t> state{unclaimed};
+		/** @brief 仅在 state == ready 后可读 */
+		std::optional<V> value;
+
+		Node(size_t h, const K& k) : hash(h), key(k) {}
+	};
+
+	/** @brief 只存节点指针，扩容时节点本身不移动 */
+	struct Table
+	{
+		size_t mask;
+		std::unique_ptr<std::atomic<Node*>[]> slots;
+
+		explicit Table(size_t capacity)
+			: mask(capacity - 1), slots(std::make_unique<std::atomic<Node*>[]>(capacity)) {}
+	};
+
+	struct alignas(64) Shard
+	{
+		std::atomic<Table*> table{nullptr};
+		std::atomic<size_t> ready{0};
+		/** @brief 保护以下成员与槽位写入 */
+		std::mutex mutex;
+		/** @brief 旧表保留到析构，无锁读者因此不会读到已释放的内存 */
+		std::vector<std::unique_ptr<Table>> tables;
+		std::deque<Node> nodes;
+	};
+
+	std::move_only_function<V(context) const> formula_;
+	[[no_unique_address]] Hash hash_;
+	[[no_unique_address]] KeyEqual equal_;
+	size_t shard_count_ = 0;
+	std::unique_ptr<Shard[]> shards_;
+
+	[[nodiscard]] Shard& shard_of(size_t h) const noexcept
+	{
+		// 高位选分片，低位选槽位
+		return shards_[(h >> 40) & (shard_count_ - 1)];
+	}
+
+	[[nodiscard]] Node* probe(const Table* t, size_t h, const K& key) const
+	{
+		if(!t) return nullptr;
+		for(size_t i = h & t->mask;; i = (i + 1) & t->mask)
+		{
+			Node* n = t->slots[i].load(std::memory_order_acquire);
+			if(!n) return nullptr;
+			if(n->hash == h && equal_(n->key, key)) return n;
+		}
+	}
+
+	static void place(Table& t, Node* n) noexcept
+	{
+		size_t i = n->hash & t.mask;
+		while(t.slots[i].load(std::memory_order_relaxed))
+			i = (i + 1) & t.mask;
+		t.slots[i].store(n, std::memory_order_release);
+	}
+
+	/** @brief 在分片锁内查找或登记节点 */
+	Node* claim_slot(Shard& s, size_t h, const K& key) const
+	{
+		std::lock_guard lock(s.mutex);
+		Table* t = s.table.load(std::memory_order_relaxed);
+		if(Node* n = probe(t, h, key)) return n;
+
+		// 负载因子不超过 1/2，探测链保持很短
+		if(!t || 2 * (s.nodes.size() + 1) > t->mask + 1)
+		{
+			auto grown = std::make_unique<Table>(t ? 2 * (t->mask + 1) : initial_slots);
+			for(Node& n : s.nodes)
+				place(*grown, &n);
+			s.tables.push_back(std::move(grown));
+			t = s.tables.back().get();
+			s.table.store(t, std::memory_order_release);
+		}
+		Node* n = &s.nodes.emplace_back(h, key);
+		place(*t, n);
+		return n;
+	}
+
+	/** @brief 取得节点的值：抢到计算权则计算，否则等待 */
+	const V& resolve(Node& node) const
+	{
+		std::uint8_t st = node.state.load(std::memory_order_acquire);
+		while(true)
+		{
+			if(st == ready) [[likely]]
+				return *node.value;
+			if(st == unclaimed)
+			{
+				if(!node.state.compare_exchange_weak(st, computing, std::memory_order_acquire))
+					continue;
+				try
+				{
+					node.value.emplace(formula_(context{node.key, *this}));
+				}
+				catch(...)
+				{
+					node.state.store(unclaimed, std::memory_order_release);
+					node.state.notify_all();
+					throw;
+				}
+				node.state.store(ready, std::memory_order_release);
+				node.state.notify_all();
+				shard_of(node.hash).ready.fetch_add(1, std::memory_order_relaxed);
+				return *node.value;
+			}
+			node.state.wait(computing, std::memory_order_acquire);
+			st = node.state.load(std::memory_order_acquire);
+		}
+	}
+};
+
+/**
+ * @brief bounded_automemo 的命中统计
+ */
+struct automemo_stats
+{
+	size_t hits = 0;
+	size_t misses = 0;
+	size_t evictions = 0;
+
+	/** @brief 命中率，尚无访问时为 0 */
+	[[nodiscard]] constexpr double hit_ratio() const noexcept
+	{
+		const size_t total = hits + misses;
+		return total ? static_cast<double>(hits) / static_cast<double>(total) : 0.0;
+	}
+};
+
+/**
+ * @class bounded_automemo
+ * @brief 内存有界的记忆化函数
+ * @note 最多缓存 capacity 个键，满时按 CLOCK (二次机会) 淘汰最近未被访问的键；
+ *       正在计算的键被钉住，递归展开期间不会被淘汰。所有键都被钉住 (递归深度超过容量) 时
+ *       新键照常计算但不缓存 (仍参与成环检测)。值按值返回，因为引用可能在后续访问中被淘汰。
+ *       与 autoseq 一样不是线程安全的，多线程共享请使用 concurrent_automemo
+ *
+ * @tparam K 键类型
+ * @tparam V 值类型
+ */
+template <typename K, typename V, typename Hash = std::hash<K>, typename KeyEqual = std::equal_to<K>>
+class bounded_automemo
+{
+public:
+	using key_type = K;
+	using mapped_type = V;
+	using context = automemo_details::MemoContext<bounded_automemo>;
+
+	/**
+	 * @param capacity 最多缓存的键数
+	 * @param f V(const K&, const bounded_automemo&) 或 V(context)
+	 */
+	template <typename F>
+	bounded_automemo(size_t capacity, F&& f, const Hash& hash = Hash(), const KeyEqual& equal = KeyEqual())
+		: formula_(automemo_details::make_memo_dispatch<bounded_automemo>(std::forward<F>(f)))
+		, hash_(hash)
+		, equal_(equal)
+		, entries_(std::max<size_t>(capacity, 1))
+		, index_(std::bit_ceil(2 * entries_.size()), npos)
+	{
+	}
+
+	/** @brief 上下文持有对象引用，禁止拷贝与移动 */
+	bounded_automemo(const bounded_automemo&) = delete;
+	bounded_automemo& operator=(const bounded_automemo&) = delete;
+
+	/**
+	 * @brief 求 f(key)，必要时计算并缓存
+	 * @throws std::logic_error 递归依赖成环 (计算某个键时又请求了它本身)
+	 */
+	[[nodiscard]] V operator()(const K& key) const
+	{
+		const size_t h = automemo_details::mix(hash_(key));
+		if(const size_t slot = lookup(h, key); slot != npos)
+		{
+			Entry& e = entries_[slot];
+			if(e.pinned) [[unlikely]]
+				throw std::logic_error("hyx::bounded_automemo: Recursive dependency on a key being computed.");
+			e.referenced = true;
+			++stats_.hits;
+			return *e.value;
+		}
+
+		for(const InFlight& f : overflow_)
+		{
+			if(f.hash == h && equal_(*f.key, key)) [[unlikely]]
+				throw std::logic_error("hyx::bounded_automemo: Recursive dependency on a key being computed.");
+		}
+
+		++stats_.misses;
+		const size_t slot = acquire_slot();
+		if(slot == npos) [[unlikely]]
+		{
+			// 全部条目被钉住：不缓存，但登记为正在计算，自依赖时同样能检测到成环
+			overflow_.push_back({h, &key});
+			try
+			{
+				V value = formula_(context{key, *this});
+				overflow_.pop_back();
+				return value;
+			}
+			catch(...)
+			{
+				overflow_.pop_back();
+				throw;
+			}
+		}
+
+		Entry& e = entries_[slot];
+		e.hash = h;
+		e.key.emplace(key);
+		e.pinned = true;
+		insert_index(slot);
+		++size_;
+		try
+		{
+			e.value.emplace(formula_(context{*e.key, *this}));
+		}
+		catch(...)
+		{
+			evict(slot);
+			throw;
+		}
+		e.pinned = false;
+		e.referenced = true;
+		return *e.value;
+	}
+
+	[[nodiscard]] V operator[](const K& key) const
+	{
+		return (*this)(key);
+	}
+
+	/**
+	 * @brief 只查不算，不影响淘汰顺序与统计
+	 * @return 已缓存时返回值的地址 (下一次访问前有效)，否则为 nullptr
+	 */
+	[[nodiscard]] const V* find(const K& key) const
+	{
+		const size_t slot = lookup(automemo_details::mix(hash_(key)), key);
+		if(slot == npos || entries_[slot].pinned) return nullptr;
+		return &*entries_[slot].value;
+	}
+
+	/** @brief 已缓存的键数 */
+	[[nodiscard]] size_t size() const noexcept
+	{
+		return size_;
+	}
+
+	[[nodiscard]] size_t capacity() const noexcept
+	{
+		return entries_.size();
+	}
+
+	[[nodiscard]] const automemo_stats& stats() const noexcept
+	{
+		return stats_;
+	}
+
+	void reset_stats() noexcept
+	{
+		stats_ = {};
+	}
+
+private:
+	static constexpr size_t npos = static_cast<size_t>(-1);
+
+	struct Entry
+	{
+		size_t hash = 0;
+		std::optional<K> key;
+		std::optional<V> value;
+		/** @brief 正在计算，不可淘汰 */
+		bool pinned = false;
+		/** @brief CLOCK 的访问位 */
+		bool referenced = false;
+	};
+
+	/** @brief 未能缓存、正在计算的键；键由调用方的参数持有，计算期间地址不变 */
+	struct InFlight
+	{
+		size_t hash;
+		const K* key;
+	};
+
+	std::move_only_function<V(context) const> formula_;
+	[[no_unique_address]] Hash hash_;
+	[[no_unique_address]] KeyEqual equal_;
+	/** @brief 定长条目数组，CLOCK 指针在其上循环 */
+	mutable std::vector<Entry> entries_;
+	/** @brief 线性探测索引：键 -> 条目下标，长度为 2 的幂且不小于容量的两倍 */
+	mutable std::vector<size_t> index_;
+	mutable size_t hand_ = 0;
+	mutable size_t size_ = 0;
+	mutable automemo_stats stats_;
+	/** @brief 未缓存的计算按递归顺序嵌套，以栈的方式进出 */
+	mutable std::vector<InFlight> overflow_;
+
+	[[nodiscard]] size_t mask() const noexcept
+	{
+		return index_.size() - 1;
+	}
+
+	[[nodiscard]] size_t lookup(size_t h, const K& key) const
+	{
+		for(size_t i = h & mask(); index_[i] != npos; i = (i + 1) & mask())
+		{
+			const Entry& e = entries_[index_[i]];
+			if(e.hash == h && equal_(*e.key, key)) return index_[i];
+		}
+		return npos;
+	}
+
+	void insert_index(size_t slot) const noexcept
+	{
+		size_t i = entries_[slot].hash & mask();
+		while(index_[i] != npos)
+			i = (i + 1) & mask();
+		index_[i] = slot;
+	}
+
+	/** @brief 后移删除，线性探测表中不留墓碑 */
+	void erase_index(size_t slot) const noexcept
+	{
+		size_t hole = entries_[slot].hash & mask();
+		while(index_[hole] != slot)
+			hole = (hole + 1) & mask();
+		for(size_t j = (hole + 1) & mask(); index_[j] != npos; j = (j + 1) & mask())
+		{
+			// 起始位置不在 (hole, j] 中的项可以前移填补空洞
+			const size_t home = entries_[index_[j]].hash & mask();
+			const bool stays = hole < j ? (hole < home && home <= j) : (hole < home || home <= j);
+			if(stays) continue;
+			index_[hole] = index_[j];
+			hole = j;
+		}
+		index_[hole] = npos;
+	}
+
+	void evict(size_t slot) const noexcept
+	{
+		erase_index(slot);
+		Entry& e = entries_[slot];
+		e.key.reset();
+		e.value.reset();
+		e.pinned = false;
+		e.referenced = false;
+		--size_;
+	}
+
+	/**
+	 * @brief CLOCK 扫描：空条目直接使用，访问位为 1 的清零后跳过，钉住的跳过
+	 * @return 可用条目，全部被钉住时为 npos
+	 */
+	[[nodiscard]] size_t acquire_slot() const noexcept
+	{
+		for(size_t step = 0; step <= 2 * entries_.size(); ++step)
+		{
+			const size_t slot = hand_;
+			hand_ = hand_ + 1 == entries_.size() ? 0 : hand_ + 1;
+			Entry& e = entries_[slot];
+			if(!e.key) return slot;
+			if(e.pinned) continue;
+			if(e.referenced)
+			{
+				e.referenced = false;
+				continue;
+			}
+			evict(slot);
+			++stats_.evictions;
+			return slot;
+		}
+		return npos;
+	}
+};
+
+} // namespace hyx
@@ -16,8 +16,10 @@
  * @license MIT License
  */
 
-#include <utility>      // std::forward, std::move, std::forward_like
+#include <utility>      // std::forward, std::move, std::exchange, std::move_if_noexcept, std::as_const
 #include <vector>       // std::vector
+#include <memory>       // std::allocator, std::allocator_traits, std::allocator_arg_t, std::unique_ptr
+#include <iterator>     // std::make_move_iterator
 #include <span>         // std::span
 #include <functional>   // std::move_only_function, std::invoke
 #include <concepts>     // std::convertible_to, std::regular_invocable
@@ -25,8 +27,29 @@
 #include <bit>          // std::bit_ceil
 #include <cassert>      // assert
 #include <cstddef>      // size_t
-#include <algorithm>    // std::max
-#include <stdexcept>    // std::out_of_range, std::invalid_argument
+#include <algorithm>    // std::max, std::min
+#include <array>        // std::array
+#include <unordered_map> // std::unordered_map
+#include <list>         // std::list
+#include <variant>      // std::variant, std::get_if
+#include <ranges>       // std::ranges::input_range, std::ranges::begin
+#include <optional>     // std::optional
+#include <deque>        // std::deque
+#include <mutex>        // std::mutex, std::unique_lock
+#include <condition_variable> // std::condition_variable
+#include <thread>       // std::thread
+#include <system_error> // std::system_error
+#include <stdexcept>    // std::out_of_range, std::invalid_argument, std::logic_error
+#include <cstdint>      // std::uintptr_t
+#include <cstring>      // std::memcpy
+
+#if defined(__linux__)
+#include <sys/mman.h>   // madvise
+#include <unistd.h>     // sysconf
+#endif
+#if defined(__SSE2__)
+#include <emmintrin.h>  // _mm_stream_si128, _mm_sfence
+#endif
 
 /**
  * @namespace hyx
@@ -34,6 +57,85 @@
 namespace hyx
 {
 
+/**
+ * @brief 公式声明的能力，供自适应调优等机制判断哪些策略是安全的
+ */
+struct autoseq_caps
+{
+	/** @brief 第 n 项最多回看到 n - lookback，std::dynamic_extent 表示不限 */
+	size_t lookback = std::dynamic_extent;
+	/** @brief 第 n 项不读取任何历史，可在空 history 上单独计算 */
+	bool history_free = false;
+};
+
+/**
+ * @brief 大量项被丢弃 (析构、trim、窗口释放) 时的回收方式
+ */
+enum class autoseq_reclaim
+{
+	/** @brief 立即同步销毁 */
+	eager,
+	/** @brief 丢弃的项在之后每次扩展时分批销毁；析构仍同步进行 */
+	incremental,
+	/** @brief 交给后台回收线程销毁并释放，析构与丢弃在关键路径上为 O(保留项数) */
+	background
+};
+
+/**
+ * @brief 构造标签：采用外部只读前缀作为初始历史
+ */
+struct adopt_prefix_t
+{
+	explicit adopt_prefix_t() = default;
+};
+inline constexpr adopt_prefix_t adopt_prefix {};
+
+/**
+ * @brief 自适应调优选择的存储/求值策略
+ */
+enum class autoseq_strategy
+{
+	/** @brief 默认：按需连续填充 */
+	dense,
+	/** @brief 顺序扫描：成批预读 */
+	read_ahead,
+	/** @brief 远距离随机跳转：跳过前缀，稀疏缓存单项 (要求 history_free) */
+	sparse,
+	/** @brief 热点集中在最新窗口：释放窗口之前的旧项 (要求 history_free) */
+	window
+};
+
+/** @brief 一次策略切换记录 */
+struct autoseq_tuning_event
+{
+	/** @brief 发生切换时累计的访问次数 */
+	size_t access;
+	autoseq_strategy from;
+	autoseq_strategy to;
+};
+
+/**
+ * @brief 自适应调优状态快照
+ */
+struct autoseq_tuning_report
+{
+	autoseq_strategy strategy = autoseq_strategy::dense;
+	/** @brief 当前预读批量 (项数) */
+	size_t read_ahead = 0;
+	/** @brief 各类访问的累计次数 */
+	size_t accesses = 0;
+	size_t sequential = 0;
+	size_t far_jumps = 0;
+	size_t window_hits = 0;
+	size_t small_repeats = 0;
+	/** @brief 稀疏缓存中的项数 */
+	size_t sparse_terms = 0;
+	/** @brief 已释放的前缀长度 */
+	size_t released = 0;
+	/** @brief 最近的策略切换 (按时间顺序) */
+	std::vector<autoseq_tuning_event> decisions;
+};
+
 /**
  * @namespace autoseq_details
  * @brief 内部实现细节
@@ -72,40 +174,852 @@ struct MathContext
 	 */
 	[[nodiscard]] constexpr const T& operator[](size_t i) const noexcept
 	{
-		assert(i < history.size() && "hyx::autoseq: Index out of range.");
-		// 允许编译器在此处消除多余的检查指令，极大提升数学公式执行速度
-		[[assume(i < history.size())]];
-		return history[i];
-	}
-};
+		assert(i < history.size() && "hyx::autoseq: Index out of range.");
+		// 允许编译器在此处消除多余的检查指令，极大提升数学公式执行速度
+		[[assume(i < history.size())]];
+		return history[i];
+	}
+};
+
+/**
+ * @brief 内联存储区，N == 0 时不占空间
+ */
+template <typename T, size_t N>
+struct InlineBuffer
+{
+	alignas(T) std::byte bytes[N * sizeof(T)];
+
+	[[nodiscard]] T* data() noexcept
+	{
+		return reinterpret_cast<T*>(bytes);
+	}
+	[[nodiscard]] const T* data() const noexcept
+	{
+		return reinterpret_cast<const T*>(bytes);
+	}
+};
+
+template <typename T>
+struct InlineBuffer<T, 0>
+{
+	[[nodiscard]] T* data() noexcept
+	{
+		return nullptr;
+	}
+	[[nodiscard]] const T* data() const noexcept
+	{
+		return nullptr;
+	}
+};
+
+/**
+ * @brief 以非临时存储复制 n 个可平凡复制的对象，写入不经过 CPU 缓存
+ * @note 首尾不足 16 字节的部分按普通方式复制，结束时 sfence；没有 SSE2 时退化为 memcpy
+ */
+template <typename T>
+void stream_copy(T* dst, const T* src, size_t n) noexcept
+{
+	static_assert(std::is_trivially_copyable_v<T>);
+	auto* d = reinterpret_cast<std::byte*>(dst);
+	auto* s = reinterpret_cast<const std::byte*>(src);
+	size_t bytes = n * sizeof(T);
+#if defined(__SSE2__)
+	const size_t head = std::min(bytes, (16 - reinterpret_cast<std::uintptr_t>(d) % 16) % 16);
+	std::memcpy(d, s, head);
+	d += head;
+	s += head;
+	bytes -= head;
+	for(; bytes >= 16; bytes -= 16, d += 16, s += 16)
+		_mm_stream_si128(reinterpret_cast<__m128i*>(d), _mm_loadu_si128(reinterpret_cast<const __m128i*>(s)));
+	std::memcpy(d, s, bytes);
+	_mm_sfence();
+#else
+	std::memcpy(d, s, bytes);
+#endif
+}
+
+/**
+ * @class SeqStorage
+ * @brief 带内联容量的连续存储
+ * @note 前 N 项存放在对象内部，超出后整体迁移到 Alloc 分配的堆内存；
+ *       也可以借用外部只读前缀，首次扩展时再复制到自有内存
+ */
+template <typename T, typename Alloc, size_t N>
+class SeqStorage
+{
+	using traits = std::allocator_traits<Alloc>;
+
+public:
+	explicit SeqStorage(const Alloc& alloc) noexcept
+		: alloc_(alloc)
+	{
+	}
+
+	SeqStorage(SeqStorage&& other) noexcept
+		: alloc_(std::move(other.alloc_))
+	{
+		take(other);
+	}
+
+	SeqStorage& operator=(SeqStorage&& other) noexcept
+	{
+		if(this != &other)
+		{
+			reset();
+			if constexpr(traits::propagate_on_container_move_assignment::value)
+				alloc_ = std::move(other.alloc_);
+			take(other);
+		}
+		return *this;
+	}
+
+	~SeqStorage()
+	{
+		reset();
+	}
+
+	[[nodiscard]] size_t size() const noexcept
+	{
+		return size_;
+	}
+	[[nodiscard]] size_t capacity() const noexcept
+	{
+		return capacity_;
+	}
+	/** @brief 已释放的前缀长度，[0, released()) 中的槽位不再持有对象 */
+	[[nodiscard]] size_t released() const noexcept
+	{
+		return released_;
+	}
+	[[nodiscard]] size_t max_size() const noexcept
+	{
+		return traits::max_size(alloc_);
+	}
+	[[nodiscard]] T* data() noexcept
+	{
+		return data_;
+	}
+	[[nodiscard]] const T* data() const noexcept
+	{
+		return data_;
+	}
+	[[nodiscard]] const T& operator[](size_t i) const noexcept
+	{
+		return data_[i];
+	}
+	[[nodiscard]] Alloc get_allocator() const noexcept
+	{
+		return alloc_;
+	}
+
+	void reserve(size_t n)
+	{
+		if(n <= capacity_) return;
+		if(n > max_size()) [[unlikely]]
+			throw std::length_error("hyx::autoseq: Requested capacity exceeds maximum container size.");
+
+		T* fresh = traits::allocate(alloc_, n);
+		relocate_to(fresh, n);
+	}
+
+	/** @brief 是否仍在借用外部前缀 */
+	[[nodiscard]] bool borrowed() const noexcept
+	{
+		return borrowed_;
+	}
+
+	/**
+	 * @brief 借用外部只读前缀，不复制也不销毁
+	 * @note p 必须在借用期间保持有效；借用期间不会写入 p
+	 */
+	void adopt(const T* p, size_t n) noexcept
+	{
+		reset();
+		// 借用期间 size_ == capacity_，任何追加都会先迁移到自有内存，因此不会经由 data_ 写入
+		data_ = const_cast<T*>(p);
+		size_ = capacity_ = n;
+		borrowed_ = true;
+	}
+
+	/**
+	 * @brief 销毁 [released(), n) 中的对象，索引保持不变
+	 * @note 之后的扩容只迁移存活部分，新缓冲区中被释放的前缀不会被触碰
+	 */
+	void release_prefix(size_t n) noexcept
+	{
+		n = std::min(n, size_);
+		if(borrowed_)
+		{
+			// 借用期间必须保持 size_ == capacity_，下一次追加才会先迁移到自有内存
+			released_ = std::max(released_, n);
+			capacity_ = size_;
+			return;
+		}
+		for(; released_ < n; ++released_)
+			traits::destroy(alloc_, data_ + released_);
+	}
+
+	/**
+	 * @brief 将 [from, to) 槽位中完整覆盖的页归还给操作系统
+	 * @note 只能用于已释放的槽位：这些槽位之后不会再被读写，页面在下次触碰时按零页重新提供
+	 */
+	void discard(size_t from, size_t to) const noexcept
+	{
+#if defined(__linux__)
+		if(!owns_heap() || from >= to) return;
+		static const std::uintptr_t page = static_cast<std::uintptr_t>(::sysconf(_SC_PAGESIZE));
+		const auto base = reinterpret_cast<std::uintptr_t>(data_);
+		std::uintptr_t lo = (base + from * sizeof(T)) & ~(page - 1);
+		if(lo < base) lo += page;
+		const std::uintptr_t hi = (base + to * sizeof(T)) & ~(page - 1);
+		if(lo < hi)
+			::madvise(reinterpret_cast<void*>(lo), hi - lo, MADV_DONTNEED);
+#else
+		(void)from, (void)to;
+#endif
+	}
+
+	/**
+	 * @brief 销毁 [n, size()) 中的对象并缩短长度
+	 */
+	void truncate(size_t n) noexcept
+	{
+		n = std::max(n, released_);
+		if(n >= size_) return;
+		if(borrowed_)
+		{
+			// 借用的前缀只读：容量随长度一起缩短，之后的追加会先迁移到自有内存而不是写入外部数据
+			size_ = capacity_ = n;
+			return;
+		}
+		for(size_t i = n; i < size_; ++i)
+			traits::destroy(alloc_, data_ + i);
+		size_ = n;
+	}
+
+	/**
+	 * @brief 只保留存活区间中的 [keep_lo, keep_hi)，其余存活对象连同旧缓冲区一起交出
+	 * @note 保留区间必须贴住存活区间 [released(), size()) 的一端；要求 owns_heap()。
+	 *       保留的项迁移到同容量的新缓冲区，索引不变，代价与保留项数成正比；
+	 *       返回的存储只持有被丢弃的对象，可在任意时刻、任意线程销毁
+	 */
+	[[nodiscard]] SeqStorage detach_except(size_t keep_lo, size_t keep_hi)
+	requires std::is_nothrow_move_constructible_v<T>
+	{
+		// owns_heap() 蕴含未借用：借用的前缀不能交出，调用方需改用 release_prefix / truncate
+		assert(owns_heap() && !borrowed_ && (keep_lo == released_ || keep_hi == size_));
+
+		T* fresh = traits::allocate(alloc_, capacity_);
+		SeqStorage old(alloc_);
+		old.data_ = std::exchange(data_, fresh);
+		old.size_ = size_;
+		old.capacity_ = capacity_;
+		old.released_ = released_;
+
+		for(size_t i = keep_lo; i < keep_hi; ++i)
+		{
+			traits::construct(alloc_, fresh + i, std::move(old.data_[i]));
+			traits::destroy(alloc_, old.data_ + i);
+		}
+		if(keep_lo == old.released_)
+			old.released_ = keep_hi;
+		else
+			old.size_ = keep_lo;
+
+		released_ = keep_lo;
+		size_ = keep_hi;
+		return old;
+	}
+
+	/**
+	 * @brief 从前缀开始销毁至多 budget 个存活对象
+	 * @return 是否已全部销毁 (此时缓冲区也已释放)
+	 */
+	bool reap(size_t budget) noexcept
+	{
+		const size_t n = std::min(size_, released_ + budget);
+		release_prefix(n);
+		if(released_ < size_) return false;
+		reset();
+		return true;
+	}
+
+	/** @brief 存活对象数 */
+	[[nodiscard]] size_t live() const noexcept
+	{
+		return size_ - released_;
+	}
+
+	[[nodiscard]] bool owns_heap() const noexcept
+	{
+		return !borrowed_ && !is_inline();
+	}
+
+	/**
+	 * @brief 以非临时存储追加 n 项
+	 * @note 容量不足时按 emplace_back 的增长策略扩容；src 不能指向本存储
+	 */
+	void append_streamed(const T* src, size_t n)
+	requires std::is_trivially_copyable_v<T>
+	{
+		if(n > capacity_ - size_)
+			reserve(std::max(size_ + n, capacity_ + (capacity_ >> 1)));
+		stream_copy(data_ + size_, src, n);
+		size_ += n;
+	}
+
+	template <typename... Args>
+	T& emplace_back(Args&&... args)
+	{
+		if(size_ == capacity_) [[unlikely]]
+		{
+			const size_t n = std::max<size_t>(16, capacity_ + (capacity_ >> 1));
+			T* fresh = traits::allocate(alloc_, n);
+			// 先构造新元素，参数可能引用旧缓冲区中的元素
+			try
+			{
+				traits::construct(alloc_, fresh + size_, std::forward<Args>(args)...);
+			}
+			catch(...)
+			{
+				traits::deallocate(alloc_, fresh, n);
+				throw;
+			}
+			relocate_to(fresh, n, 1);
+		}
+		else
+		{
+			traits::construct(alloc_, data_ + size_, std::forward<Args>(args)...);
+		}
+		return data_[size_++];
+	}
+
+private:
+	[[no_unique_address]] Alloc alloc_;
+	[[no_unique_address]] InlineBuffer<T, N> inline_;
+	T* data_ = inline_.data();
+	size_t size_ = 0;
+	size_t capacity_ = N;
+	size_t released_ = 0;
+	bool borrowed_ = false;
+
+	/**
+	 * @brief 数据是否位于内联存储区
+	 * @note 按地址判断而不是比较容量：借用前缀之后的 reserve 可能恰好分配 N 项的堆缓冲区
+	 */
+	[[nodiscard]] bool is_inline() const noexcept
+	{
+		return data_ == inline_.data();
+	}
+
+	/**
+	 * @brief 将已有元素迁移到新缓冲区
+	 * @param constructed 新缓冲区中 size_ 之后已构造的元素个数 (失败时一并销毁)
+	 */
+	void relocate_to(T* fresh, size_t n, size_t constructed = 0)
+	{
+		size_t moved = released_;
+		try
+		{
+			for(; moved < size_; ++moved)
+			{
+				if(borrowed_)
+					traits::construct(alloc_, fresh + moved, std::as_const(data_[moved]));
+				else
+					traits::construct(alloc_, fresh + moved, std::move_if_noexcept(data_[moved]));
+			}
+		}
+		catch(...)
+		{
+			for(size_t i = released_; i < moved; ++i)
+				traits::destroy(alloc_, fresh + i);
+			for(size_t i = 0; i < constructed; ++i)
+				traits::destroy(alloc_, fresh + size_ + i);
+			traits::deallocate(alloc_, fresh, n);
+			throw;
+		}
+		destroy_all();
+		if(owns_heap())
+			traits::deallocate(alloc_, data_, capacity_);
+		data_ = fresh;
+		capacity_ = n;
+		borrowed_ = false;
+	}
+
+	void destroy_all() noexcept
+	{
+		if(borrowed_) return;
+		for(size_t i = released_; i < size_; ++i)
+			traits::destroy(alloc_, data_ + i);
+	}
+
+	void reset() noexcept
+	{
+		destroy_all();
+		if(owns_heap())
+			traits::deallocate(alloc_, data_, capacity_);
+		data_ = inline_.data();
+		size_ = 0;
+		capacity_ = N;
+		released_ = 0;
+		borrowed_ = false;
+	}
+
+	/** @brief 接管 other 的内容，other 被置空 */
+	void take(SeqStorage& other) noexcept
+	{
+		if(other.borrowed_ || (!other.is_inline() && alloc_ == other.alloc_))
+		{
+			data_ = std::exchange(other.data_, other.inline_.data());
+			size_ = std::exchange(other.size_, 0);
+			capacity_ = std::exchange(other.capacity_, N);
+			released_ = std::exchange(other.released_, 0);
+			borrowed_ = std::exchange(other.borrowed_, false);
+			return;
+		}
+		if(other.size_ > N)
+		{
+			data_ = traits::allocate(alloc_, other.size_);
+			capacity_ = other.size_;
+		}
+		released_ = size_ = other.released_;
+		for(; size_ < other.size_; ++size_)
+			traits::construct(alloc_, data_ + size_, std::move(other.data_[size_]));
+		other.reset();
+	}
+};
+
+/**
+ * @class AccessTuner
+ * @brief 访问模式统计与策略决策
+ * @note 以固定长度的访问为一个周期，周期结束时按各类访问的占比切换策略
+ */
+template <typename T>
+class AccessTuner
+{
+public:
+	static constexpr size_t epoch_length = 256;
+	static constexpr size_t small_index_limit = 64;
+	static constexpr size_t min_read_ahead = 64;
+	static constexpr size_t max_read_ahead = size_t{1} << 16;
+	static constexpr size_t max_events = 64;
+	static constexpr size_t max_sparse_terms = 4096;
+
+	explicit AccessTuner(const autoseq_caps& caps) noexcept
+	{
+		set_caps(caps);
+	}
+
+	/**
+	 * @brief 同步 autoseq 重新声明的能力
+	 * @note 不再 history_free 时，依赖它的稀疏与窗口策略立即退回 dense
+	 */
+	void set_caps(const autoseq_caps& caps) noexcept
+	{
+		window_length_ = caps.lookback == std::dynamic_extent ? 1024 : std::max<size_t>(1024, caps.lookback);
+		history_free_ = caps.history_free;
+		if(!history_free_ && (strategy_ == autoseq_strategy::sparse || strategy_ == autoseq_strategy::window))
+			switch_to(autoseq_strategy::dense);
+	}
+
+	/**
+	 * @brief 取稀疏缓存中的第 n 项，缺失时以 compute() 计算并加入
+	 * @note 最多保留 max_sparse_terms 项，超出时淘汰最久未访问的项；返回的引用在该项被淘汰前有效
+	 */
+	template <typename F>
+	const T& sparse_term(size_t n, F&& compute)
+	{
+		if(auto it = sparse_index_.find(n); it != sparse_index_.end())
+		{
+			sparse_.splice(sparse_.begin(), sparse_, it->second);
+			return it->second->second;
+		}
+		// 先计算再淘汰，compute 抛出时缓存保持不变
+		T value = compute();
+		if(sparse_.size() == max_sparse_terms)
+		{
+			sparse_index_.erase(sparse_.back().first);
+			sparse_.pop_back();
+		}
+		sparse_.emplace_front(n, std::move(value));
+		try
+		{
+			sparse_index_.emplace(n, sparse_.begin());
+		}
+		catch(...)
+		{
+			sparse_.pop_front();
+			throw;
+		}
+		return sparse_.front().second;
+	}
+
+	[[nodiscard]] autoseq_strategy strategy() const noexcept
+	{
+		return strategy_;
+	}
+	[[nodiscard]] size_t read_ahead() const noexcept
+	{
+		return read_ahead_;
+	}
+	[[nodiscard]] size_t window_length() const noexcept
+	{
+		return window_length_;
+	}
+
+	/**
+	 * @brief 记录一次访问
+	 * @param n 访问的索引
+	 * @param frontier 访问前已连续缓存的项数
+	 */
+	void observe(size_t n, size_t frontier) noexcept
+	{
+		++total_.accesses;
+		if(last_ != std::dynamic_extent && n == last_ + 1)
+			++epoch_.sequential;
+		else if(is_far(n, frontier))
+			++epoch_.far_jumps;
+		else if(n < small_index_limit && n < frontier)
+			++epoch_.small_repeats;
+		else if(n < frontier && frontier - n <= window_length_)
+			++epoch_.window_hits;
+		last_ = n;
+
+		if(++epoch_.accesses == epoch_length)
+			decide();
+	}
+
+	/** @brief 访问点远超缓存前沿，连续填充的代价超过已有缓存本身 */
+	[[nodiscard]] static bool is_far(size_t n, size_t frontier) noexcept
+	{
+		return n >= frontier && n - frontier >= std::max<size_t>(4096, frontier);
+	}
+
+	void fill_report(autoseq_tuning_report& r) const
+	{
+		r.strategy = strategy_;
+		r.read_ahead = read_ahead_;
+		r.accesses = total_.accesses;
+		r.sequential = total_.sequential + epoch_.sequential;
+		r.far_jumps = total_.far_jumps + epoch_.far_jumps;
+		r.window_hits = total_.window_hits + epoch_.window_hits;
+		r.small_repeats = total_.small_repeats + epoch_.small_repeats;
+		r.sparse_terms = sparse_.size();
+
+		const size_t count = std::min(event_count_, max_events);
+		r.decisions.reserve(count);
+		for(size_t i = event_count_ - count; i < event_count_; ++i)
+			r.decisions.push_back(events_[i % max_events]);
+	}
+
+private:
+	struct Counters
+	{
+		size_t accesses = 0;
+		size_t sequential = 0;
+		size_t far_jumps = 0;
+		size_t window_hits = 0;
+		size_t small_repeats = 0;
+	};
+
+	Counters epoch_;
+	Counters total_;
+	std::array<autoseq_tuning_event, max_events> events_{};
+	size_t event_count_ = 0;
+	size_t last_ = std::dynamic_extent;
+	size_t read_ahead_ = 0;
+	size_t window_length_ = 1024;
+	bool history_free_ = false;
+	autoseq_strategy strategy_ = autoseq_strategy::dense;
+	/** @brief 稀疏缓存：按最近访问排序的链表，节点地址稳定，另以索引表查找 */
+	std::list<std::pair<size_t, T>> sparse_;
+	std::unordered_map<size_t, typename std::list<std::pair<size_t, T>>::iterator> sparse_index_;
+
+	void switch_to(autoseq_strategy next) noexcept
+	{
+		if(next == strategy_) return;
+		events_[event_count_++ % max_events] = {total_.accesses, strategy_, next};
+		strategy_ = next;
+	}
+
+	void decide() noexcept
+	{
+		const size_t e = epoch_.accesses;
+		autoseq_strategy next = autoseq_strategy::dense;
+		if(epoch_.sequential * 4 >= e * 3)
+			next = autoseq_strategy::read_ahead;
+		else if(epoch_.far_jumps * 2 >= e && history_free_)
+			next = autoseq_strategy::sparse;
+		else if(epoch_.window_hits * 4 >= e * 3 && history_free_)
+			next = autoseq_strategy::window;
+
+		if(next == autoseq_strategy::read_ahead)
+			read_ahead_ = read_ahead_ ? std::min(read_ahead_ * 2, max_read_ahead) : min_read_ahead;
+		else
+			read_ahead_ = 0;
+
+		switch_to(next);
+
+		total_.sequential += epoch_.sequential;
+		total_.far_jumps += epoch_.far_jumps;
+		total_.window_hits += epoch_.window_hits;
+		total_.small_repeats += epoch_.small_repeats;
+		epoch_ = {};
+	}
+};
+
+/**
+ * @class Reclaimer
+ * @brief 后台回收线程
+ * @note 首次提交时启动；实例有意不销毁，以便静态存储期的 autoseq 在进程退出阶段仍能提交
+ */
+class Reclaimer
+{
+public:
+	static Reclaimer& instance()
+	{
+		static Reclaimer* const self = new Reclaimer();
+		return *self;
+	}
+
+	/** @brief 提交一个回收任务，无法启动线程时就地执行 */
+	void post(std::move_only_function<void()> job)
+	{
+		std::unique_lock lock(mutex_);
+		if(!started_)
+		{
+			try
+			{
+				std::thread([this] { run(); }).detach();
+				started_ = true;
+			}
+			catch(const std::system_error&)
+			{
+				lock.unlock();
+				job();
+				return;
+			}
+		}
+		queue_.push_back(std::move(job));
+		wake_.notify_one();
+	}
+
+	/** @brief 阻塞直到已提交的任务全部完成 */
+	void wait_idle()
+	{
+		std::unique_lock lock(mutex_);
+		idle_.wait(lock, [this] { return queue_.empty() && busy_ == 0; });
+	}
+
+private:
+	std::mutex mutex_;
+	std::condition_variable wake_;
+	std::condition_variable idle_;
+	std::deque<std::move_only_function<void()>> queue_;
+	size_t busy_ = 0;
+	bool started_ = false;
+
+	Reclaimer() = default;
+
+	[[noreturn]] void run()
+	{
+		std::unique_lock lock(mutex_);
+		while(true)
+		{
+			wake_.wait(lock, [this] { return !queue_.empty(); });
+			auto job = std::move(queue_.front());
+			queue_.pop_front();
+			++busy_;
+			lock.unlock();
+			// 任务本身即是被丢弃的存储，执行并析构后即完成回收
+			job();
+			job = nullptr;
+			lock.lock();
+			--busy_;
+			if(queue_.empty() && busy_ == 0)
+				idle_.notify_all();
+		}
+	}
+};
+
+/**
+ * @class TermSink
+ * @brief 批量公式的输出端
+ * @note 一次调用可以追加任意多项；本次调用追加的项在返回后才并入 history。
+ *       多项输出公式会被反复调用直到覆盖请求的索引，因此必须最终产出新项
+ */
+template <typename T>
+class TermSink
+{
+public:
+	TermSink(std::vector<T>& out, size_t first, size_t wanted) noexcept
+		: out_(out), first_(first), wanted_(wanted)
+	{
+	}
+
+	/** @brief 下一项的索引 */
+	[[nodiscard]] size_t n() const noexcept
+	{
+		return first_ + out_.size();
+	}
+
+	/** @brief 本次请求是否已经满足 (满足后仍可继续追加) */
+	[[nodiscard]] bool satisfied() const noexcept
+	{
+		return out_.size() >= wanted_;
+	}
+
+	/** @brief 追加一项 */
+	template <typename... Args>
+	T& emit(Args&&... args)
+	{
+		return out_.emplace_back(std::forward<Args>(args)...);
+	}
+
+private:
+	std::vector<T>& out_;
+	size_t first_;
+	size_t wanted_;
+};
+
+/** @brief 按值返回新项的公式 */
+template <typename T>
+using ValueFormula = std::move_only_function<T(size_t, std::span<const T>)>;
+
+/** @brief 就地写入新项的公式，out 可能是回收池中带有容量的旧对象 */
+template <typename T>
+using InPlaceFormula = std::move_only_function<void(T&, size_t, std::span<const T>)>;
+
+/** @brief 每次调用追加零或多项的公式，history 为调用开始时的已计算部分 */
+template <typename T>
+using BatchFormula = std::move_only_function<void(TermSink<T>&, std::span<const T>)>;
+
+template <typename T>
+using Formula = std::variant<ValueFormula<T>, InPlaceFormula<T>, BatchFormula<T>>;
+
+/** @brief 元素可转换为 T 的输入范围 (如 std::generator<T>) */
+template <typename R, typename T>
+concept term_range = std::ranges::input_range<R> && std::convertible_to<std::ranges::range_reference_t<R>, T>;
+
+/** @brief 无参调用后返回 term_range 的生成器工厂 */
+template <typename F, typename T>
+concept term_factory = std::invocable<F> && term_range<std::invoke_result_t<F>, T>;
+
+/**
+ * @brief 将输入范围包装为批量公式：每次恢复到满足请求为止，并一直持有范围 (协程帧)
+ */
+template <typename T, typename R>
+BatchFormula<T> make_range_formula(R&& range)
+{
+	using Range = std::remove_cvref_t<R>;
+	return [r = std::forward<R>(range), it = std::optional<std::ranges::iterator_t<Range>> {}, pending = false]
+	       (TermSink<T>& sink, std::span<const T>) mutable
+	{
+		if(!it) it.emplace(std::ranges::begin(r));
+		auto& cur = *it;
+		// 上次调用停在最后产出的项上，到下次请求时才前进，不提前恢复生成器计算用不到的项
+		if(pending)
+		{
+			pending = false;
+			++cur;
+		}
+		while(!sink.satisfied())
+		{
+			if(cur == std::ranges::end(r)) [[unlikely]]
+				throw std::out_of_range("hyx::autoseq: Generator exhausted before the requested index.");
+			sink.emit(*cur);
+			if(sink.satisfied())
+			{
+				pending = true;
+				break;
+			}
+			++cur;
+		}
+	};
+}
 
 /**
  * @brief 智能签名适配
+ * @note 就地模式的公式请写明参数类型，泛型 lambda 可能被误判为模式 A
+ * @param alloc 容器的分配器，转交给接受 std::allocator_arg 的生成器工厂以分配协程帧
  */
-template <typename T, typename F>
-constexpr auto make_dispatch(F&& f)
+template <typename T, typename F, typename Alloc = std::allocator<T>>
+constexpr Formula<T> make_dispatch(F&& f, const Alloc& alloc = Alloc())
 {
 	using Context = MathContext<T>;
 
 	// 模式 A: 双参数原始模式 (size_t n, std::span history)
 	if constexpr(std::is_invocable_r_v<T, F, size_t, std::span<const T>>)
 	{
-		return[f = std::forward<F>(f)](size_t n, std::span<const T> h) mutable -> T
+		return ValueFormula<T>([f = std::forward<F>(f)](size_t n, std::span<const T> h) mutable -> T
 		{
 			return static_cast<T>(std::invoke(f, n, h));
-		};
+		});
 	}
 	// 模式 B: 单参数数学上下文模式 (MathContext)
 	else if constexpr(std::is_invocable_r_v<T, F, Context>)
 	{
-		return [f = std::forward<F>(f)](size_t n, std::span<const T> h) mutable -> T
+		return ValueFormula<T>([f = std::forward<F>(f)](size_t n, std::span<const T> h) mutable -> T
 		{
 			return static_cast<T>(std::invoke(f, Context{n, h}));
-		};
+		});
+	}
+	// 模式 C: 就地原始模式 void(T& out, size_t n, std::span history)
+	else if constexpr(std::is_invocable_v<F, T&, size_t, std::span<const T>>)
+	{
+		static_assert(std::default_initializable<T>, "hyx::autoseq: In-place formulas require a default-constructible T.");
+		return InPlaceFormula<T>([f = std::forward<F>(f)](T& out, size_t n, std::span<const T> h) mutable
+		{
+			std::invoke(f, out, n, h);
+		});
+	}
+	// 模式 D: 就地数学上下文模式 void(T& out, MathContext)
+	else if constexpr(std::is_invocable_v<F, T&, Context>)
+	{
+		static_assert(std::default_initializable<T>, "hyx::autoseq: In-place formulas require a default-constructible T.");
+		return InPlaceFormula<T>([f = std::forward<F>(f)](T& out, size_t n, std::span<const T> h) mutable
+		{
+			std::invoke(f, out, Context{n, h});
+		});
+	}
+	// 模式 E: 生成器 / 输入范围 (如 std::generator<T>)，按批恢复
+	else if constexpr(term_range<F, T>)
+	{
+		return make_range_formula<T>(std::forward<F>(f));
+	}
+	// 模式 F: 生成器工厂 (std::allocator_arg_t, const Alloc&)，协程帧由容器的分配器分配
+	else if constexpr(std::is_invocable_v<F, std::allocator_arg_t, const Alloc&>)
+	{
+		static_assert(term_range<std::invoke_result_t<F, std::allocator_arg_t, const Alloc&>, T>,
+		              "hyx::autoseq: Generator factory must return a range of T.");
+		return make_range_formula<T>(std::invoke(std::forward<F>(f), std::allocator_arg, alloc));
+	}
+	// 模式 G: 无参生成器工厂，如返回 std::generator<T> 的协程 lambda
+	else if constexpr(term_factory<F, T>)
+	{
+		return make_range_formula<T>(std::invoke(std::forward<F>(f)));
+	}
+	// 模式 H: 多项输出 void(MathContext, TermSink&)，每次调用追加零或多项，直到覆盖请求的索引
+	else if constexpr(std::is_invocable_v<F, Context, TermSink<T>&>)
+	{
+		return BatchFormula<T>([f = std::forward<F>(f)](TermSink<T>& sink, std::span<const T> h) mutable
+		{
+			std::invoke(f, Context{sink.n(), h}, sink);
+		});
+	}
+	// 模式 I: 多项输出原始模式 void(size_t n, std::span history, TermSink&)
+	else if constexpr(std::is_invocable_v<F, size_t, std::span<const T>, TermSink<T>&>)
+	{
+		return BatchFormula<T>([f = std::forward<F>(f)](TermSink<T>& sink, std::span<const T> h) mutable
+		{
+			std::invoke(f, sink.n(), h, sink);
+		});
 	}
 	else
 	{
-		static_assert(false, "hyx::autoseq: Unrecognized formula signature. Expected T(size_t, span) or T(MathContext).");
+		static_assert(false, "hyx::autoseq: Unrecognized formula signature. Expected T(size_t, span), T(MathContext), "
+		                     "void(T&, size_t, span), void(T&, MathContext), void(MathContext, TermSink&), "
+		                     "void(size_t, span, TermSink&) or a generator of T.");
 	}
 }
 
@@ -116,21 +1030,197 @@ constexpr auto make_dispatch(F&& f)
  * @brief 动态数学数列容器
  *
  * @tparam T 数值类型
+ * @tparam Alloc 缓存使用的分配器 (如 hyx::numa_allocator<T>)
+ * @tparam InlineCapacity 内联容量，前 InlineCapacity 项存放在对象内部而不分配堆内存
  */
-template <typename T>
+template <typename T, typename Alloc = std::allocator<T>, size_t InlineCapacity = 0>
 class autoseq
 {
 	static_assert(!std::is_reference_v<T>, "hyx::autoseq: Element type cannot be a reference.");
 
 private:
 	/** @brief 项数据缓存 */
-	mutable std::vector<T> cache_;
+	mutable autoseq_details::SeqStorage<T, Alloc, InlineCapacity> cache_;
 
 	/**
 	 * @brief 生成公式封装
-	 * @note 使用 move_only_function 允许 lambda 捕获不可拷贝对象 (如 unique_ptr)
+	 * @note 使用 move_only_function 允许 lambda 捕获不可拷贝对象 (如 unique_ptr)；
+	 *       捕获超出其内部缓冲区 (实现定义，通常为两个指针) 的 lambda 仍会分配堆内存
+	 */
+	mutable autoseq_details::Formula<T> formula_;
+
+	/** @brief 批量公式的暂存区，每次调用后并入缓存 */
+	mutable std::vector<T> staging_;
+
+	/** @brief 回收池：被丢弃项的对象连同其容量交给就地公式复用 */
+	mutable std::vector<T> pool_;
+
+	/** @brief 回收池容量上限，0 表示不回收 */
+	size_t pool_limit_ = 0;
+
+	/** @brief 公式声明的能力 */
+	autoseq_caps caps_;
+
+	/** @brief 追加观察者，未设置时为空 */
+	mutable std::move_only_function<void(size_t, std::span<const T>)> observer_;
+
+	/** @brief 自适应调优器，未启用时为空 */
+	mutable std::unique_ptr<autoseq_details::AccessTuner<T>> tuner_;
+
+	/** @brief 回收方式 */
+	autoseq_reclaim reclaim_ = autoseq_reclaim::eager;
+
+	/** @brief incremental 方式下等待分批销毁的旧存储 */
+	mutable std::vector<autoseq_details::SeqStorage<T, Alloc, InlineCapacity>> graveyard_;
+
+	/** @brief 丢弃项数低于该值时总是同步销毁 */
+	static constexpr size_t reclaim_threshold = size_t{1} << 12;
+	/** @brief incremental 方式下每次扩展销毁的项数 */
+	static constexpr size_t reap_budget = size_t{1} << 12;
+
+	/** @brief 单次扩展不少于该项数时以非临时存储写入缓存，0 表示关闭 */
+	size_t stream_threshold_ = 0;
+	/** @brief 流式填充时每块暂存的字节数，约为 L1 数据缓存的一半 */
+	static constexpr size_t stream_block_bytes = size_t{1} << 14;
+
+	/** @brief 本次扩展是否走流式填充 */
+	[[nodiscard]] bool streams(size_t extension) const noexcept
+	{
+		if constexpr(std::is_trivially_copyable_v<T>)
+			return stream_threshold_ != 0 && extension >= stream_threshold_ &&
+			       (formula_.index() == 2 || (formula_.index() == 0 && caps_.history_free));
+		else
+			return false;
+	}
+
+	[[nodiscard]] static constexpr size_t stream_block() noexcept
+	{
+		return std::max<size_t>(64, stream_block_bytes / sizeof(T));
+	}
+
+	/** @brief 将暂存区并入缓存，流式填充时使用非临时存储 */
+	void commit_staging(bool streaming) const
+	{
+		if constexpr(std::is_trivially_copyable_v<T>)
+		{
+			if(streaming)
+			{
+				cache_.append_streamed(staging_.data(), staging_.size());
+				return;
+			}
+		}
+		for(auto& v : staging_) cache_.emplace_back(std::move(v));
+	}
+
+	/**
+	 * @brief history_free 按值公式的流式填充：逐块在暂存区中计算，再整块并入缓存
+	 */
+	void stream_values(size_t needed_size) const
+	{
+		auto& value = std::get<0>(formula_);
+		while(cache_.size() < needed_size)
+		{
+			const size_t first = cache_.size();
+			const size_t count = std::min(stream_block(), needed_size - first);
+			staging_.clear();
+			try
+			{
+				for(size_t i = 0; i < count; ++i)
+					staging_.push_back(value(first + i, std::span<const T> {}));
+			}
+			catch(...)
+			{
+				commit_staging(true);
+				throw;
+			}
+			commit_staging(true);
+		}
+	}
+
+	/**
+	 * @brief 按回收方式丢弃存活区间一端的项，只保留 [keep_lo, keep_hi)
+	 */
+	void drop_except(size_t keep_lo, size_t keep_hi) const
+	{
+		recycle(keep_lo > cache_.released() ? cache_.released() : keep_hi,
+		        keep_lo > cache_.released() ? keep_lo : cache_.size());
+
+		const size_t dropped = cache_.live() - (keep_hi - keep_lo);
+		if constexpr(std::is_nothrow_move_constructible_v<T>)
+		{
+			if(reclaim_ != autoseq_reclaim::eager && dropped >= reclaim_threshold && cache_.owns_heap())
+			{
+				auto old = cache_.detach_except(keep_lo, keep_hi);
+				if(reclaim_ == autoseq_reclaim::background)
+					autoseq_details::Reclaimer::instance().post([old = std::move(old)] {});
+				else
+					graveyard_.push_back(std::move(old));
+				return;
+			}
+		}
+		cache_.release_prefix(keep_lo);
+		cache_.truncate(keep_hi);
+	}
+
+	/**
+	 * @brief 将即将丢弃的 [lo, hi) 中的对象移入回收池
+	 * @note 只有就地公式会从池中取用，因此其它公式不做回收
+	 */
+	void recycle(size_t lo, size_t hi) const
+	{
+		if(pool_limit_ == 0 || formula_.index() != 1 || cache_.borrowed()) return;
+		if constexpr(std::is_nothrow_move_constructible_v<T>)
+		{
+			T* data = cache_.data();
+			for(size_t i = lo; i < hi && pool_.size() < pool_limit_; ++i)
+				pool_.push_back(std::move(data[i]));
+		}
+	}
+
+	/** @brief 从回收池取出一个对象，池空时默认构造 */
+	[[nodiscard]] T take_recycled() const
+	{
+		if constexpr(std::default_initializable<T>)
+		{
+			if(pool_.empty()) return T{};
+			T out = std::move(pool_.back());
+			pool_.pop_back();
+			return out;
+		}
+		else
+		{
+			std::unreachable();
+		}
+	}
+
+	/**
+	 * @brief 单独计算第 n 项 (不写入缓存)
 	 */
-	mutable std::move_only_function<T(size_t, std::span<const T>)> formula_;
+	[[nodiscard]] T evaluate(size_t n, std::span<const T> history) const
+	{
+		if(auto* value = std::get_if<0>(&formula_))
+			return (*value)(n, history);
+		if(formula_.index() == 2) [[unlikely]]
+			throw std::logic_error("hyx::autoseq: Batch formulas cannot evaluate a single term.");
+
+		T out = take_recycled();
+		std::get<1>(formula_)(out, n, history);
+		return out;
+	}
+
+	/** @brief incremental 方式下分批销毁旧存储 */
+	void reap() const noexcept
+	{
+		size_t budget = reap_budget;
+		while(!graveyard_.empty() && budget > 0)
+		{
+			auto& old = graveyard_.back();
+			const size_t step = std::min(budget, old.live());
+			budget -= step;
+			if(old.reap(step))
+				graveyard_.pop_back();
+		}
+	}
 
 	/**
 	 * @brief 确保计算达到指定的数学索引 (核心优化函数)
@@ -139,6 +1229,9 @@ private:
 	{
 		if(target_index < cache_.size()) [[likely]] return;
 
+		if(!graveyard_.empty()) [[unlikely]]
+			reap();
+
 		const size_t needed_size = target_index + 1;
 
 		// 避免 O(N^2) 内存重分配开销
@@ -152,12 +1245,149 @@ private:
 			cache_.reserve(new_cap);
 		}
 
+		const size_t before = cache_.size();
+		if(!observer_) [[likely]]
+		{
+			extend(needed_size);
+			return;
+		}
+		// 公式抛出时已算出的项同样保留在缓存中，观察者也应看到它们
+		try
+		{
+			extend(needed_size);
+		}
+		catch(...)
+		{
+			notify_observer(before);
+			throw;
+		}
+		notify_observer(before);
+	}
+
+	/** @brief 按数学索引排列的缓存，公式与内部访问用；[0, released()) 部分不可读取 */
+	[[nodiscard]] std::span<const T> history() const noexcept
+	{
+		return std::span<const T> {cache_.data(), cache_.size()};
+	}
+
+	/** @brief 已释放的项能否在空 history 上单独重算：批量公式只能按顺序产出，不能 */
+	[[nodiscard]] bool recomputable() const noexcept
+	{
+		return caps_.history_free && formula_.index() != 2;
+	}
+
+	/**
+	 * @brief 交给调优器的有效能力
+	 * @note 窗口与稀疏策略依赖单独重算已释放或跳过的项，批量公式即使声明了 history_free 也做不到
+	 */
+	[[nodiscard]] autoseq_caps tuner_caps() const noexcept
+	{
+		autoseq_caps caps = caps_;
+		caps.history_free = recomputable();
+		return caps;
+	}
+
+	/** @brief 把 [before, size()) 中新追加的项交给观察者 */
+	void notify_observer(size_t before) const
+	{
+		if(cache_.size() > before)
+			observer_(before, history().subspan(before));
+	}
+
+	/**
+	 * @brief 按公式类型把缓存扩展到 needed_size 项，调用前容量已足够
+	 */
+	void extend(size_t needed_size) const
+	{
+		const bool streaming = streams(needed_size - cache_.size());
+
 		// 执行时地址稳定保证：由于上面已经 reserve，此处循环内绝对不会发生 reallocation
 		// 这保证了传递给 formula_ 的 span 中的指针在执行期间严格安全
-		while(cache_.size() < needed_size)
+		if(streaming && formula_.index() == 0) [[unlikely]]
+		{
+			stream_values(needed_size);
+		}
+		else if(auto* value = std::get_if<0>(&formula_)) [[likely]]
+		{
+			while(cache_.size() < needed_size)
+			{
+				cache_.emplace_back((*value)(cache_.size(), history()));
+			}
+		}
+		else if(auto* batch = std::get_if<2>(&formula_))
+		{
+			// 每次调用后立即并入缓存，下一次调用即可看到上一次追加的项
+			while(cache_.size() < needed_size)
+			{
+				staging_.clear();
+				// 流式填充时按块请求，暂存区保持在缓存友好的大小
+				const size_t wanted = needed_size - cache_.size();
+				autoseq_details::TermSink<T> sink(staging_, cache_.size(), streaming ? std::min(wanted, stream_block()) : wanted);
+				try
+				{
+					(*batch)(sink, history());
+				}
+				catch(...)
+				{
+					// 已产出的项不可重放 (生成器已前进)，先保留再抛出
+					commit_staging(streaming);
+					throw;
+				}
+				commit_staging(streaming);
+			}
+		}
+		else
+		{
+			auto& in_place = std::get<1>(formula_);
+			while(cache_.size() < needed_size)
+			{
+				const size_t n = cache_.size();
+				T& out = cache_.emplace_back(take_recycled());
+				try
+				{
+					in_place(out, n, history().first(n));
+				}
+				catch(...)
+				{
+					cache_.truncate(n);
+					throw;
+				}
+			}
+		}
+	}
+
+	/**
+	 * @brief 启用调优时的访问路径
+	 */
+	const T& tuned_access(size_t n) const
+	{
+		auto& tuner = *tuner_;
+		const size_t frontier = cache_.size();
+		tuner.observe(n, frontier);
+
+		// 已释放的项、远距离跳转以及稀疏策略下前缀之外的项：history_free 公式可以单独计算
+		assert((n >= cache_.released() || recomputable()) && "hyx::autoseq: Term has been released.");
+		const bool below = n < cache_.released() && recomputable();
+		const bool beyond = n >= frontier && recomputable() &&
+		                    (tuner.strategy() == autoseq_strategy::sparse || tuner.is_far(n, frontier));
+		if(below || beyond)
+		{
+			return tuner.sparse_term(n, [&] { return evaluate(n, std::span<const T> {}); });
+		}
+
+		if(n >= frontier && tuner.read_ahead() > 0)
+			ensure_calculated(std::min(n + tuner.read_ahead(), cache_.max_size() - 1));
+		else
+			ensure_calculated(n);
+
+		if(tuner.strategy() == autoseq_strategy::window)
 		{
-			cache_.emplace_back(formula_(cache_.size(), std::span<const T> {cache_}));
+			const size_t keep = tuner.window_length();
+			// 保留区间从 n 起算，刚访问的项不会被释放
+			if(cache_.live() > 2 * keep)
+				drop_except(std::min(n, cache_.size() - keep), cache_.size());
 		}
+		return cache_[n];
 	}
 
 public:
@@ -167,16 +1397,49 @@ public:
 	template <typename Gen, typename... InitArgs>
 	requires(std::convertible_to<InitArgs, T> && ...)
 	explicit autoseq(Gen&& g, InitArgs&&... init_values)
-		: formula_(autoseq_details::make_dispatch<T>(std::forward<Gen>(g)))
+		: autoseq(std::allocator_arg, Alloc(), std::forward<Gen>(g), std::forward<InitArgs>(init_values)...)
 	{
-		if constexpr(sizeof...(init_values) > 0)
+	}
+
+	/**
+	 * @brief 使用指定分配器的构造函数
+	 */
+	template <typename Gen, typename... InitArgs>
+	requires(std::convertible_to<InitArgs, T> && ...)
+	autoseq(std::allocator_arg_t, const Alloc& alloc, Gen&& g, InitArgs&&... init_values)
+		: cache_(alloc)
+		, formula_(autoseq_details::make_dispatch<T>(std::forward<Gen>(g), alloc))
+	{
+		if constexpr(sizeof...(init_values) > InlineCapacity)
 		{
 			cache_.reserve(sizeof...(init_values));
+		}
+		if constexpr(sizeof...(init_values) > 0)
+		{
 			// 直接使用 emplace_back 折叠表达式，省去多余的强转和复制
 			(cache_.emplace_back(std::forward<InitArgs>(init_values)), ...);
 		}
 	}
 
+	/**
+	 * @brief 采用外部只读前缀的构造函数
+	 * @param prefix 预先计算好的前 prefix.size() 项，通常来自编译期生成的静态数组
+	 * @note 前缀不会被复制，必须比 autoseq 活得更久；首次计算超出前缀的项时整体复制到自有缓存
+	 */
+	template <typename Gen>
+	autoseq(adopt_prefix_t, std::span<const T> prefix, Gen&& g)
+		: autoseq(std::allocator_arg, Alloc(), adopt_prefix, prefix, std::forward<Gen>(g))
+	{
+	}
+
+	template <typename Gen>
+	autoseq(std::allocator_arg_t, const Alloc& alloc, adopt_prefix_t, std::span<const T> prefix, Gen&& g)
+		: cache_(alloc)
+		, formula_(autoseq_details::make_dispatch<T>(std::forward<Gen>(g), alloc))
+	{
+		cache_.adopt(prefix.data(), prefix.size());
+	}
+
 	/** @brief 显式禁止拷贝 (因 formula_ 可能持有 move-only 对象) */
 	autoseq(const autoseq&) = delete;
 	autoseq& operator=(const autoseq&) = delete;
@@ -185,8 +1448,18 @@ public:
 	autoseq(autoseq&&) noexcept = default;
 	autoseq& operator=(autoseq&&) noexcept = default;
 
-	/** @brief 默认析构函数 */
-	~autoseq() = default;
+	/**
+	 * @brief 析构函数
+	 * @note background 方式下大缓存交给后台回收线程，析构本身为 O(1)
+	 */
+	~autoseq()
+	{
+		if(reclaim_ != autoseq_reclaim::background) return;
+		if(cache_.live() < reclaim_threshold && graveyard_.empty()) return;
+		if(!cache_.owns_heap() && graveyard_.empty()) return;
+
+		autoseq_details::Reclaimer::instance().post([cache = std::move(cache_), graveyard = std::move(graveyard_)] {});
+	}
 
 	/**
 	 * @brief 访问数列第 n 项 (a_n)
@@ -194,6 +1467,9 @@ public:
 	 */
 	[[nodiscard]] const T& operator[](size_t n) const noexcept
 	{
+		if(tuner_) [[unlikely]]
+			return tuned_access(n);
+		assert(n >= cache_.released() && "hyx::autoseq: Term has been released.");
 		ensure_calculated(n);
 		return cache_[n];
 	}
@@ -205,6 +1481,11 @@ public:
 	{
 		if(n >= cache_.max_size()) [[unlikely]]
 			throw std::out_of_range("hyx::autoseq: Index exceeds maximum container size.");
+		// 已释放的项只有 history_free 的非批量公式在调优路径上可以单独重算
+		if(n < cache_.released() && !(tuner_ && recomputable())) [[unlikely]]
+			throw std::out_of_range("hyx::autoseq: Term has been released.");
+		if(tuner_) [[unlikely]]
+			return tuned_access(n);
 		ensure_calculated(n);
 		return cache_[n];
 	}
@@ -217,6 +1498,109 @@ public:
 		ensure_calculated(n);
 	}
 
+	/**
+	 * @brief 丢弃第 n 项及之后的缓存，之后访问时重新计算
+	 * @note 按 set_reclaim 指定的方式回收；若前缀已被释放，至少保留公式重算所需的回看区间
+	 */
+	void trim(size_t n) const
+	{
+		if(cache_.released() > 0 && !caps_.history_free)
+		{
+			const size_t lookback = std::min(caps_.lookback, cache_.size() - cache_.released());
+			n = std::max(n, cache_.released() + lookback);
+		}
+		n = std::max(n, cache_.released());
+		if(n >= cache_.size()) return;
+		drop_except(cache_.released(), n);
+	}
+
+	/**
+	 * @brief 释放第 n 项之前的缓存，适合只从前往后遍历一次的消费者
+	 * @note 保留公式计算下一项仍需回看的尾部 (caps().lookback 项)，全局索引不变；
+	 *       被释放区间中完整的页通过 MADV_DONTNEED 归还给操作系统。
+	 *       之后经 at / slice 访问已释放的项会抛出 std::out_of_range
+	 * @throws std::logic_error 未通过 set_caps 声明有限的 lookback 或 history_free
+	 */
+	void release_before(size_t n) const
+	{
+		if(!caps_.history_free && caps_.lookback == std::dynamic_extent) [[unlikely]]
+			throw std::logic_error("hyx::autoseq: release_before requires a bounded lookback or history_free caps.");
+
+		const size_t tail = caps_.history_free ? 0 : std::min(caps_.lookback, cache_.size());
+		const size_t keep_lo = std::min(n, cache_.size() - tail);
+		const size_t before = cache_.released();
+		if(keep_lo <= before) return;
+
+		drop_except(keep_lo, cache_.size());
+		cache_.discard(before, keep_lo);
+	}
+
+	/**
+	 * @brief 设置回收池容量
+	 * @note 仅对就地公式 void(T&, ...) 生效：被 trim / 窗口策略丢弃的项会移入回收池，
+	 *       生成新项时作为 out 交给公式，公式对其赋值即可复用已有容量。
+	 *       滑动窗口场景下容量不小于窗口长度即可做到稳态零分配
+	 */
+	void set_recycling(size_t limit)
+	{
+		pool_limit_ = limit;
+		if(pool_.size() > limit)
+			pool_.erase(pool_.begin() + static_cast<std::ptrdiff_t>(limit), pool_.end());
+	}
+
+	/** @brief 回收池中当前可复用的对象数 */
+	[[nodiscard]] size_t recycled() const noexcept
+	{
+		return pool_.size();
+	}
+
+	/**
+	 * @brief 设置大量项被丢弃时的回收方式
+	 */
+	void set_reclaim(autoseq_reclaim mode) noexcept
+	{
+		reclaim_ = mode;
+	}
+
+	/** @brief 获取回收方式 */
+	[[nodiscard]] autoseq_reclaim reclaim() const noexcept
+	{
+		return reclaim_;
+	}
+
+	/**
+	 * @brief 设置流式填充阈值
+	 * @note 单次扩展 (prefetch_up_to、预读等) 不少于 min_terms 项时，新项先在约 16 KiB 的暂存区中成块生成，
+	 *       再以非临时存储写入缓存，避免大批量填充挤出其它线程在末级缓存中的工作集。
+	 *       仅对可平凡复制的 T 生效，且公式需为多项输出公式，或通过 set_caps 声明了 history_free 的按值公式；
+	 *       其它公式需要经 history 读取刚写入的项，仍按普通方式填充。0 表示关闭
+	 */
+	void set_streaming(size_t min_terms) noexcept
+	{
+		stream_threshold_ = min_terms;
+	}
+
+	/** @brief 获取流式填充阈值 */
+	[[nodiscard]] size_t streaming() const noexcept
+	{
+		return stream_threshold_;
+	}
+
+	/**
+	 * @brief 设置追加观察者
+	 * @note 每次扩展缓存后以 (first, terms) 调用一次，terms 为新追加的第 [first, first + terms.size()) 项，
+	 *       适合增量维护分位数、基数等流式统计。安装时先以仍可读取的第 [released(), size()) 项调用一次，
+	 *       观察者因此看到全部未释放的项；调优路径上单独计算、不写入缓存的项不会经过观察者。
+	 *       回调中不得扩展本数列；传入空函数表示取消
+	 * @throws 回放已有项时观察者抛出的异常，此时观察者仍保持安装
+	 */
+	void set_observer(std::move_only_function<void(size_t, std::span<const T>)> observer)
+	{
+		observer_ = std::move(observer);
+		if(observer_ && cache_.size() > cache_.released())
+			observer_(cache_.released(), view());
+	}
+
 	/**
 	 * @brief 预分配缓存容量
 	 */
@@ -234,27 +1618,83 @@ public:
 			throw std::invalid_argument("hyx::autoseq: Invalid slice range (start > end).");
 		if(start == end) return {};
 
+		if(tuner_) [[unlikely]]
+			tuner_->observe(start, cache_.size());
+		if(start < cache_.released()) [[unlikely]]
+			throw std::out_of_range("hyx::autoseq: Slice covers released terms.");
 		ensure_calculated(end - 1);
-		return std::span<const T> {cache_}.subspan(start, end - start);
+		return history().subspan(start, end - start);
+	}
+
+	/**
+	 * @brief 声明公式能力
+	 * @note 自适应调优只会在声明允许的范围内切换策略
+	 */
+	void set_caps(const autoseq_caps& caps) noexcept
+	{
+		caps_ = caps;
+		if(tuner_)
+			tuner_->set_caps(tuner_caps());
+	}
+
+	/** @brief 获取已声明的公式能力 */
+	[[nodiscard]] const autoseq_caps& caps() const noexcept
+	{
+		return caps_;
+	}
+
+	/**
+	 * @brief 启用或关闭自适应调优
+	 * @note 启用后 operator[] / at / slice 会统计访问模式，并据此在预读、稀疏缓存、
+	 *       窗口释放之间切换。稀疏与窗口策略要求先通过 set_caps 声明 history_free，且公式不是批量 (TermSink) 公式。
+	 *       窗口策略释放的旧项经 operator[] / at 访问时会单独重算，经 slice 访问时抛出异常。
+	 *       稀疏缓存最多保留最近访问的 4096 项，由它返回的引用在该项被淘汰之前有效
+	 */
+	void enable_tuning(bool on = true)
+	{
+		if(on && !tuner_)
+			tuner_ = std::make_unique<autoseq_details::AccessTuner<T>>(tuner_caps());
+		else if(!on)
+			tuner_.reset();
+	}
+
+	/**
+	 * @brief 获取自适应调优的统计与决策记录
+	 */
+	[[nodiscard]] autoseq_tuning_report tuning_report() const
+	{
+		autoseq_tuning_report r;
+		if(tuner_)
+			tuner_->fill_report(r);
+		r.released = cache_.released();
+		return r;
 	}
 
 	/**
 	 * @brief 获取当前已缓存数据的只读视图
+	 * @note 与 begin() 一致，从第 released() 项开始；视图的第 i 个元素是数列第 released() + i 项
 	 */
 	[[nodiscard]] std::span<const T> view() const noexcept
 	{
-		return std::span<const T> {cache_};
+		return history().subspan(cache_.released());
 	}
 
 	/**
 	 * @brief 转换为 vector
 	 */
 	template <typename Self>
-	[[nodiscard]] std::vector<T> snapshot(this Self&& self)
+	[[nodiscard]] std::vector<T, Alloc> snapshot(this Self&& self)
 	{
-		// 如果 self 是右值，forward_like 会将 cache_ 转为右值引用从而触发移动构造；
-		// 如果 self 是左值，则退化为拷贝构造。
-		return std::forward_like<Self>(self.cache_);
+		if(self.cache_.released() > 0) [[unlikely]]
+			throw std::out_of_range("hyx::autoseq: Cannot snapshot a sequence whose prefix has been released.");
+
+		auto first = self.cache_.data();
+		auto last = first + self.cache_.size();
+		// 如果 self 是右值，逐项移动；如果 self 是左值，则退化为拷贝。
+		if constexpr(std::is_lvalue_reference_v<Self>)
+			return std::vector<T, Alloc>(first, last, self.cache_.get_allocator());
+		else
+			return std::vector<T, Alloc>(std::make_move_iterator(first), std::make_move_iterator(last), self.cache_.get_allocator());
 	}
 
 	/** @brief 获取当前已缓存的数据项总数 */
@@ -263,18 +1703,45 @@ public:
 		return cache_.size();
 	}
 
+	/** @brief 已释放的前缀长度，[0, released()) 中的项不再驻留 */
+	[[nodiscard]] size_t released() const noexcept
+	{
+		return cache_.released();
+	}
+
+	/** @brief 获取缓存使用的分配器 */
+	[[nodiscard]] Alloc get_allocator() const noexcept
+	{
+		return cache_.get_allocator();
+	}
+
 	using value_type = T;
-	using const_iterator = typename std::vector<T>::const_iterator;
+	using allocator_type = Alloc;
+	using const_iterator = const T*;
 
 	/** @brief 获取当前已缓存部分的起始/结束迭代器 */
 	[[nodiscard]] const_iterator begin() const noexcept
 	{
-		return cache_.begin();
+		return cache_.data() + cache_.released();
 	}
 	[[nodiscard]] const_iterator end() const noexcept
 	{
-		return cache_.end();
+		return cache_.data() + cache_.size();
 	}
 };
 
+/**
+ * @brief 阻塞直到后台回收线程处理完所有已提交的缓存
+ */
+inline void wait_reclaimed()
+{
+	autoseq_details::Reclaimer::instance().wait_idle();
+}
+
+/**
+ * @brief 前 N 项无需堆分配的 autoseq
+ */
+template <typename T, size_t N>
+using small_autoseq = autoseq<T, std::allocator<T>, N>;
+
 } // namespace hyx
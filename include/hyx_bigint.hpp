@@ -0,0 +1,1335 @@
+#pragma once
+
+#include <version>
+#if __cplusplus < 202302L
+#error "hyx_bigint.hpp requires C++23 or later."
+#endif
+
+/**
+ * @file hyx_bigint.hpp
+ * @brief 面向数列计算的任意精度整数
+ * @note 32 位 limb，4 个 limb 以内不分配堆内存；运算的中间结果使用线程局部的暂存区，
+ *       结果写回目标对象已有的容量，因此配合 autoseq 的就地公式与回收池可做到稳态零分配。
+ *       乘法按规模选择 schoolbook / Karatsuba / 三模数 NTT，除法为 Knuth D 与 Newton 倒数 + Barrett，
+ *       十进制转换为分治算法
+ *
+ * @version 1.0.0
+ * @author Heylyx841
+ * @date 2026-10-18
+ * @license MIT License
+ */
+
+#include <cstdint>      // std::uint32_t, std::uint64_t
+#include <cstddef>      // size_t
+#include <cstring>      // std::memmove, std::memcpy
+#include <cmath>        // std::ldexp
+#include <algorithm>    // std::max, std::min, std::fill_n, std::copy_n, std::swap
+#include <bit>          // std::bit_ceil, std::countl_zero, std::bit_width
+#include <compare>      // std::strong_ordering
+#include <concepts>     // std::integral
+#include <deque>        // std::deque
+#include <vector>       // std::vector
+#include <span>         // std::span
+#include <string>       // std::string
+#include <string_view>  // std::string_view
+#include <ostream>      // std::ostream
+#include <utility>      // std::exchange, std::pair
+#include <type_traits>  // std::make_unsigned_t, std::is_signed_v
+#include <stdexcept>    // std::invalid_argument, std::domain_error
+
+/**
+ * @namespace hyx
+ */
+namespace hyx
+{
+
+/**
+ * @namespace bigint_details
+ * @brief 内部实现细节
+ */
+namespace bigint_details
+{
+
+using limb = std::uint32_t;
+using dlimb = std::uint64_t;
+
+/** @brief 较短因子达到该 limb 数时使用 Karatsuba */
+inline constexpr size_t karatsuba_threshold = 32;
+/** @brief 较短因子达到该 limb 数时使用 NTT */
+inline constexpr size_t ntt_threshold = 1024;
+/** @brief 三模数 NTT 的最大变换长度 (受 998244353 的 2-adic 阶限制，也保证系数不超出模数乘积) */
+inline constexpr size_t ntt_max_length = size_t{1} << 23;
+/** @brief 除数与商都达到该 limb 数时使用 Newton 倒数 + Barrett */
+inline constexpr size_t newton_threshold = 64;
+/** @brief 十进制转换的分治基准规模 (limb) */
+inline constexpr size_t decimal_threshold = 48;
+
+/**
+ * @class LimbBuffer
+ * @brief 带内联存储的 limb 数组，低位在前
+ */
+class LimbBuffer
+{
+public:
+	static constexpr size_t inline_limbs = 4;
+
+	LimbBuffer() noexcept = default;
+
+	LimbBuffer(const LimbBuffer& other)
+	{
+		assign(other.data(), other.size_);
+	}
+
+	LimbBuffer(LimbBuffer&& other) noexcept
+		: heap_(std::exchange(other.heap_, nullptr))
+		, size_(std::exchange(other.size_, 0))
+		, capacity_(std::exchange(other.capacity_, inline_limbs))
+	{
+		if(!heap_) std::copy_n(other.inline_, size_, inline_);
+	}
+
+	LimbBuffer& operator=(const LimbBuffer& other)
+	{
+		if(this != &other) assign(other.data(), other.size_);
+		return *this;
+	}
+
+	LimbBuffer& operator=(LimbBuffer&& other) noexcept
+	{
+		if(this != &other)
+		{
+			release();
+			heap_ = std::exchange(other.heap_, nullptr);
+			size_ = std::exchange(other.size_, 0);
+			capacity_ = std::exchange(other.capacity_, inline_limbs);
+			if(!heap_) std::copy_n(other.inline_, size_, inline_);
+		}
+		return *this;
+	}
+
+	~LimbBuffer()
+	{
+		release();
+	}
+
+	[[nodiscard]] limb* data() noexcept
+	{
+		return heap_ ? heap_ : inline_;
+	}
+	[[nodiscard]] const limb* data() const noexcept
+	{
+		return heap_ ? heap_ : inline_;
+	}
+	[[nodiscard]] size_t size() const noexcept
+	{
+		return size_;
+	}
+	[[nodiscard]] size_t capacity() const noexcept
+	{
+		return capacity_;
+	}
+
+	/** @brief 扩容并保留已有内容 */
+	void reserve(size_t n)
+	{
+		if(n <= capacity_) return;
+		n = std::max(n, capacity_ + (capacity_ >> 1));
+		limb* fresh = new limb[n];
+		std::copy_n(data(), size_, fresh);
+		delete[] heap_;
+		heap_ = fresh;
+		capacity_ = n;
+	}
+
+	/** @brief 调整长度，新增的高位为 0 */
+	void resize(size_t n)
+	{
+		reserve(n);
+		if(n > size_) std::fill_n(data() + size_, n - size_, limb {0});
+		size_ = n;
+	}
+
+	/** @brief 复制 [p, p + n)，容量足够时不分配；p 可以指向自身 */
+	void assign(const limb* p, size_t n)
+	{
+		if(n > capacity_)
+		{
+			limb* fresh = new limb[n];
+			std::copy_n(p, n, fresh);
+			delete[] heap_;
+			heap_ = fresh;
+			capacity_ = n;
+		}
+		else if(n > 0)
+		{
+			std::memmove(data(), p, n * sizeof(limb));
+		}
+		size_ = n;
+	}
+
+	/** @brief 去掉高位的 0 */
+	void trim() noexcept
+	{
+		const limb* d = data();
+		while(size_ > 0 && d[size_ - 1] == 0) --size_;
+	}
+
+	void set_size(size_t n) noexcept
+	{
+		size_ = n;
+	}
+
+private:
+	limb* heap_ = nullptr;
+	size_t size_ = 0;
+	size_t capacity_ = inline_limbs;
+	limb inline_[inline_limbs] = {};
+
+	void release() noexcept
+	{
+		delete[] heap_;
+		heap_ = nullptr;
+		capacity_ = inline_limbs;
+	}
+};
+
+/**
+ * @class Scratch
+ * @brief 线程局部暂存区，按嵌套深度复用缓冲区
+ * @note 同一线程内按栈的顺序租用与归还；缓冲区只增不减，稳态下不再分配
+ */
+class Scratch
+{
+public:
+	explicit Scratch(size_t n)
+		: depth_(level()++)
+	{
+		auto& pool = buffers();
+		if(pool.size() <= depth_) pool.resize(depth_ + 1);
+		if(pool[depth_].size() < n) pool[depth_].resize(std::max(n, pool[depth_].size() * 2));
+		data_ = pool[depth_].data();
+	}
+
+	Scratch(const Scratch&) = delete;
+	Scratch& operator=(const Scratch&) = delete;
+
+	~Scratch()
+	{
+		--level();
+	}
+
+	[[nodiscard]] limb* data() const noexcept
+	{
+		return data_;
+	}
+
+private:
+	size_t depth_;
+	limb* data_;
+
+	static size_t& level() noexcept
+	{
+		thread_local size_t depth = 0;
+		return depth;
+	}
+
+	static std::vector<std::vector<limb>>& buffers()
+	{
+		thread_local std::vector<std::vector<limb>> pool;
+		return pool;
+	}
+};
+
+/** @brief 比较两个已去掉高位 0 的绝对值 */
+[[nodiscard]] inline int compare(const limb* a, size_t an, const limb* b, size_t bn) noexcept
+{
+	if(an != bn) return an < bn ? -1 : 1;
+	for(size_t i = an; i-- > 0;)
+	{
+		if(a[i] != b[i]) return a[i] < b[i] ? -1 : 1;
+	}
+	return 0;
+}
+
+/**
+ * @brief r[0, an) = a + b，要求 an >= bn；r 可以与 a 或 b 重合
+ * @return 最高位进位
+ */
+inline limb add(limb* r, const limb* a, size_t an, const limb* b, size_t bn) noexcept
+{
+	dlimb c = 0;
+	size_t i = 0;
+	for(; i < bn; ++i)
+	{
+		c += dlimb {a[i]} + b[i];
+		r[i] = static_cast<limb>(c);
+		c >>= 32;
+	}
+	for(; i < an; ++i)
+	{
+		c += a[i];
+		r[i] = static_cast<limb>(c);
+		c >>= 32;
+	}
+	return static_cast<limb>(c);
+}
+
+/**
+ * @brief r[0, an) = a - b，要求 a >= b；r 可以与 a 或 b 重合
+ */
+inline void sub(limb* r, const limb* a, size_t an, const limb* b, size_t bn) noexcept
+{
+	dlimb borrow = 0;
+	size_t i = 0;
+	for(; i < bn; ++i)
+	{
+		const dlimb t = dlimb {a[i]} - b[i] - borrow;
+		r[i] = static_cast<limb>(t);
+		borrow = t >> 63;
+	}
+	for(; i < an; ++i)
+	{
+		const dlimb t = dlimb {a[i]} - borrow;
+		r[i] = static_cast<limb>(t);
+		borrow = t >> 63;
+	}
+}
+
+/**
+ * @brief r[0, n) += a[0, n) * m
+ * @return 溢出到 r[n] 的进位
+ */
+inline limb addmul_1(limb* r, const limb* a, size_t n, limb m) noexcept
+{
+	dlimb c = 0;
+	for(size_t i = 0; i < n; ++i)
+	{
+		c += dlimb {a[i]} * m + r[i];
+		r[i] = static_cast<limb>(c);
+		c >>= 32;
+	}
+	return static_cast<limb>(c);
+}
+
+/**
+ * @brief r[0, n) -= a[0, n) * m
+ * @return 需要从 r[n] 借走的值
+ */
+inline limb submul_1(limb* r, const limb* a, size_t n, limb m) noexcept
+{
+	dlimb c = 0;
+	for(size_t i = 0; i < n; ++i)
+	{
+		const dlimb p = dlimb {a[i]} * m + c;
+		const auto lo = static_cast<limb>(p);
+		c = (p >> 32) + (r[i] < lo);
+		r[i] -= lo;
+	}
+	return static_cast<limb>(c);
+}
+
+/** @brief r[0, an + bn) = a * b，r 不得与输入重合 */
+inline void mul_school(limb* r, const limb* a, size_t an, const limb* b, size_t bn) noexcept
+{
+	std::fill_n(r, an + bn, limb {0});
+	for(size_t j = 0; j < bn; ++j)
+		r[j + an] = addmul_1(r + j, a, an, b[j]);
+}
+
+/**
+ * @class NttPrime
+ * @brief 模 Mod 的数论变换，原根为 3
+ */
+template <limb Mod>
+struct NttPrime
+{
+	static constexpr limb mod = Mod;
+
+	[[nodiscard]] static constexpr limb pow(limb a, dlimb e) noexcept
+	{
+		dlimb r = 1, x = a;
+		for(; e; e >>= 1, x = x * x % Mod)
+		{
+			if(e & 1) r = r * x % Mod;
+		}
+		return static_cast<limb>(r);
+	}
+
+	/** @brief 正变换 (DIF)：自然序输入，位反转序输出 */
+	static void forward(limb* a, size_t n) noexcept
+	{
+		for(size_t len = n >> 1; len >= 1; len >>= 1)
+		{
+			const dlimb step = pow(3, (Mod - 1) / (2 * len));
+			for(size_t i = 0; i < n; i += 2 * len)
+			{
+				dlimb w = 1;
+				for(size_t j = 0; j < len; ++j)
+				{
+					const limb u = a[i + j], v = a[i + j + len];
+					a[i + j] = u + v >= Mod ? u + v - Mod : u + v;
+					a[i + j + len] = static_cast<limb>((dlimb {u} + Mod - v) * w % Mod);
+					w = w * step % Mod;
+				}
+			}
+		}
+	}
+
+	/** @brief 逆变换 (DIT)：位反转序输入，自然序输出，含 1/n */
+	static void inverse(limb* a, size_t n) noexcept
+	{
+		for(size_t len = 1; len < n; len <<= 1)
+		{
+			const dlimb step = pow(pow(3, Mod - 2), (Mod - 1) / (2 * len));
+			for(size_t i = 0; i < n; i += 2 * len)
+			{
+				dlimb w = 1;
+				for(size_t j = 0; j < len; ++j)
+				{
+					const limb u = a[i + j];
+					const auto v = static_cast<limb>(a[i + j + len] * w % Mod);
+					a[i + j] = u + v >= Mod ? u + v - Mod : u + v;
+					a[i + j + len] = u >= v ? u - v : u + Mod - v;
+					w = w * step % Mod;
+				}
+			}
+		}
+		const dlimb inv_n = pow(static_cast<limb>(n % Mod), Mod - 2);
+		for(size_t i = 0; i < n; ++i)
+			a[i] = static_cast<limb>(a[i] * inv_n % Mod);
+	}
+
+	/** @brief out[0, an + bn - 1) = a * b mod Mod 的各系数；fa, fb 为长度 len 的工作区 */
+	static void convolve(const limb* a, size_t an, const limb* b, size_t bn, size_t len, limb* fa, limb* fb, limb* out) noexcept
+	{
+		const bool square = a == b && an == bn;
+		for(size_t i = 0; i < len; ++i)
+			fa[i] = i < an ? a[i] % Mod : 0;
+		forward(fa, len);
+		if(square)
+		{
+			for(size_t i = 0; i < len; ++i)
+				fa[i] = static_cast<limb>(dlimb {fa[i]} * fa[i] % Mod);
+		}
+		else
+		{
+			for(size_t i = 0; i < len; ++i)
+				fb[i] = i < bn ? b[i] % Mod : 0;
+			forward(fb, len);
+			for(size_t i = 0; i < len; ++i)
+				fa[i] = static_cast<limb>(dlimb {fa[i]} * fb[i] % Mod);
+		}
+		inverse(fa, len);
+		std::copy_n(fa, an + bn - 1, out);
+	}
+};
+
+using Ntt1 = NttPrime<998244353>;
+using Ntt2 = NttPrime<167772161>;
+using Ntt3 = NttPrime<469762049>;
+
+/**
+ * @brief 三模数 NTT 乘法，系数经 Garner 合并后进位
+ * @note 每个系数小于 min(an, bn) * 2^64 <= 2^86，小于三个模数之积
+ */
+inline void mul_ntt(limb* r, const limb* a, size_t an, const limb* b, size_t bn)
+{
+	const size_t len = std::bit_ceil(an + bn - 1);
+	const size_t m = an + bn - 1;
+	Scratch work(2 * len + 3 * m);
+	limb* fa = work.data();
+	limb* fb = fa + len;
+	limb* r1 = fb + len;
+	limb* r2 = r1 + m;
+	limb* r3 = r2 + m;
+	Ntt1::convolve(a, an, b, bn, len, fa, fb, r1);
+	Ntt2::convolve(a, an, b, bn, len, fa, fb, r2);
+	Ntt3::convolve(a, an, b, bn, len, fa, fb, r3);
+
+	constexpr dlimb m1 = Ntt1::mod, m2 = Ntt2::mod, m3 = Ntt3::mod;
+	constexpr dlimb inv12 = Ntt2::pow(static_cast<limb>(m1 % m2), m2 - 2);
+	constexpr dlimb inv13 = Ntt3::pow(static_cast<limb>(m1 % m3), m3 - 2);
+	constexpr dlimb inv23 = Ntt3::pow(static_cast<limb>(m2 % m3), m3 - 2);
+
+	unsigned __int128 carry = 0;
+	for(size_t i = 0; i < an + bn; ++i)
+	{
+		if(i < m)
+		{
+			const dlimb x1 = r1[i];
+			const dlimb v2 = (r2[i] + m2 - x1 % m2) % m2 * inv12 % m2;
+			const dlimb v3 = ((r3[i] + m3 - x1 % m3) % m3 * inv13 % m3 + m3 - v2 % m3) % m3 * inv23 % m3;
+			carry += x1 + static_cast<unsigned __int128>(v2) * m1 + static_cast<unsigned __int128>(v3) * (m1 * m2);
+		}
+		r[i] = static_cast<limb>(carry);
+		carry >>= 32;
+	}
+}
+
+inline void mul(limb* r, const limb* a, size_t an, const limb* b, size_t bn);
+
+/** @brief an >= 2bn：把 a 切成 bn 长的段分别相乘后累加 */
+inline void mul_unbalanced(limb* r, const limb* a, size_t an, const limb* b, size_t bn)
+{
+	std::fill_n(r, an + bn, limb {0});
+	Scratch part(2 * bn);
+	for(size_t off = 0; off < an; off += bn)
+	{
+		const size_t len = std::min(bn, an - off);
+		mul(part.data(), a + off, len, b, bn);
+		add(r + off, r + off, len + bn, part.data(), len + bn);
+	}
+}
+
+/**
+ * @brief Karatsuba：要求 bn <= an < 2bn
+ * @note a = a1 β^h + a0，b = b1 β^h + b0，中间项 (a0 + a1)(b0 + b1) - z0 - z2
+ */
+inline void mul_karatsuba(limb* r, const limb* a, size_t an, const limb* b, size_t bn)
+{
+	const size_t h = an / 2; // bn > h，因此 b1 非空
+	mul(r, a, h, b, h);
+	mul(r + 2 * h, a + h, an - h, b + h, bn - h);
+
+	const size_t la = an - h + 1;
+	const size_t lb = std::max(h, bn - h) + 1;
+	Scratch work(2 * (la + lb));
+	limb* sa = work.data();
+	limb* sb = sa + la;
+	limb* z1 = sb + lb;
+	sa[la - 1] = add(sa, a + h, an - h, a, h);
+	sb[lb - 1] = h >= bn - h ? add(sb, b, h, b + h, bn - h) : add(sb, b + h, bn - h, b, h);
+	mul(z1, sa, la, sb, lb);
+	sub(z1, z1, la + lb, r, 2 * h);
+	sub(z1, z1, la + lb, r + 2 * h, an + bn - 2 * h);
+	add(r + h, r + h, an + bn - h, z1, std::min(la + lb, an + bn - h));
+}
+
+/** @brief r[0, an + bn) = a * b，按规模选择算法；r 不得与输入重合 */
+inline void mul(limb* r, const limb* a, size_t an, const limb* b, size_t bn)
+{
+	if(an < bn)
+	{
+		std::swap(a, b);
+		std::swap(an, bn);
+	}
+	if(bn == 0)
+	{
+		std::fill_n(r, an, limb {0});
+		return;
+	}
+	if(bn < karatsuba_threshold)
+		mul_school(r, a, an, b, bn);
+	else if(bn >= ntt_threshold && an + bn <= ntt_max_length)
+		mul_ntt(r, a, an, b, bn);
+	else if(an >= 2 * bn)
+		mul_unbalanced(r, a, an, b, bn);
+	else
+		mul_karatsuba(r, a, an, b, bn);
+}
+
+/**
+ * @struct PreparedDivisor
+ * @brief 规范化后的除数 (最高位为 1) 及其倒数，对同一除数重复做除法时复用
+ */
+template <typename Int>
+struct PreparedDivisor
+{
+	Int normalized;
+	Int reciprocal;
+	unsigned shift = 0;
+};
+
+} // namespace bigint_details
+
+/**
+ * @class bigint
+ * @brief 任意精度有符号整数
+ * @note 语义与内置整数一致：除法向零截断，余数与被除数同号；移位作用于绝对值。
+ *       可直接作为 autoseq 的元素类型；就地公式可使用 assign_product / add_mul / mul_small 复用 out 的容量
+ */
+class bigint
+{
+public:
+	using limb = bigint_details::limb;
+
+	bigint() noexcept = default;
+
+	template <std::integral I>
+	requires(!std::is_same_v<I, bool>)
+	bigint(I value)
+	{
+		using U = std::make_unsigned_t<I>;
+		U mag = static_cast<U>(value);
+		if constexpr(std::is_signed_v<I>)
+		{
+			if(value < 0)
+			{
+				negative_ = true;
+				mag = static_cast<U>(U {0} - mag);
+			}
+		}
+		std::uint64_t v = mag;
+		limb buf[2] = {static_cast<limb>(v), static_cast<limb>(v >> 32)};
+		mag_.assign(buf, 2);
+		mag_.trim();
+	}
+
+	/**
+	 * @brief 由十进制字符串构造，可带前导 '+' 或 '-'
+	 * @throws std::invalid_argument 含有非数字字符或为空
+	 */
+	explicit bigint(std::string_view decimal)
+	{
+		bool neg = false;
+		if(!decimal.empty() && (decimal.front() == '-' || decimal.front() == '+'))
+		{
+			neg = decimal.front() == '-';
+			decimal.remove_prefix(1);
+		}
+		if(decimal.empty()) [[unlikely]]
+			throw std::invalid_argument("hyx::bigint: Empty decimal string.");
+		for(char c : decimal)
+		{
+			if(c < '0' || c > '9') [[unlikely]]
+				throw std::invalid_argument("hyx::bigint: Invalid decimal digit.");
+		}
+		*this = parse_digits(decimal);
+		negative_ = neg && !is_zero();
+	}
+
+	[[nodiscard]] bool is_zero() const noexcept
+	{
+		return mag_.size() == 0;
+	}
+
+	/** @brief -1, 0 或 1 */
+	[[nodiscard]] int sign() const noexcept
+	{
+		return is_zero() ? 0 : (negative_ ? -1 : 1);
+	}
+
+	explicit operator bool() const noexcept
+	{
+		return !is_zero();
+	}
+
+	/** @brief 绝对值的二进制位数 */
+	[[nodiscard]] size_t bit_length() const noexcept
+	{
+		if(is_zero()) return 0;
+		return 32 * (mag_.size() - 1) + std::bit_width(mag_.data()[mag_.size() - 1]);
+	}
+
+	/** @brief 绝对值的 limb，低位在前 */
+	[[nodiscard]] std::span<const limb> limbs() const noexcept
+	{
+		return {mag_.data(), mag_.size()};
+	}
+
+	/** @brief 预留 limb 容量 */
+	void reserve(size_t limbs)
+	{
+		mag_.reserve(limbs);
+	}
+
+	[[nodiscard]] size_t capacity() const noexcept
+	{
+		return mag_.capacity();
+	}
+
+	/** @brief 近似为 double (截断到最高的 64 位有效位) */
+	explicit operator double() const noexcept
+	{
+		const size_t n = mag_.size();
+		double v = 0;
+		const size_t low = n > 3 ? n - 3 : 0;
+		for(size_t i = n; i-- > low;)
+			v = v * 4294967296.0 + mag_.data()[i];
+		v = std::ldexp(v, static_cast<int>(32 * low));
+		return negative_ ? -v : v;
+	}
+
+	// ---------------- 就地运算 ----------------
+
+	/** @brief *this = a * b，复用自身容量 */
+	bigint& assign_product(const bigint& a, const bigint& b)
+	{
+		if(a.is_zero() || b.is_zero())
+		{
+			clear();
+			return *this;
+		}
+		const size_t n = a.mag_.size() + b.mag_.size();
+		bigint_details::Scratch work(n);
+		bigint_details::mul(work.data(), a.mag_.data(), a.mag_.size(), b.mag_.data(), b.mag_.size());
+		set_magnitude(work.data(), n, a.negative_ != b.negative_);
+		return *this;
+	}
+
+	/** @brief *this += a * b */
+	bigint& add_mul(const bigint& a, const bigint& b)
+	{
+		if(a.is_zero() || b.is_zero()) return *this;
+		const size_t n = a.mag_.size() + b.mag_.size();
+		bigint_details::Scratch work(n);
+		bigint_details::mul(work.data(), a.mag_.data(), a.mag_.size(), b.mag_.data(), b.mag_.size());
+		size_t pn = n;
+		while(pn > 0 && work.data()[pn - 1] == 0) --pn;
+		add_magnitude(work.data(), pn, a.negative_ != b.negative_);
+		return *this;
+	}
+
+	/** @brief *this *= m */
+	bigint& mul_small(std::uint32_t m)
+	{
+		if(m == 0)
+		{
+			clear();
+			return *this;
+		}
+		const size_t n = mag_.size();
+		mag_.reserve(n + 1);
+		limb* d = mag_.data();
+		bigint_details::dlimb c = 0;
+		for(size_t i = 0; i < n; ++i)
+		{
+			c += bigint_details::dlimb {d[i]} * m;
+			d[i] = static_cast<limb>(c);
+			c >>= 32;
+		}
+		if(c)
+		{
+			mag_.set_size(n + 1);
+			d[n] = static_cast<limb>(c);
+		}
+		return *this;
+	}
+
+	/**
+	 * @brief *this /= d，返回余数的绝对值
+	 * @throws std::domain_error d == 0
+	 */
+	std::uint32_t div_small(std::uint32_t d)
+	{
+		if(d == 0) [[unlikely]]
+			throw std::domain_error("hyx::bigint: Division by zero.");
+		bigint_details::dlimb rem = 0;
+		limb* p = mag_.data();
+		for(size_t i = mag_.size(); i-- > 0;)
+		{
+			const bigint_details::dlimb cur = (rem << 32) | p[i];
+			p[i] = static_cast<limb>(cur / d);
+			rem = cur % d;
+		}
+		normalize();
+		return static_cast<std::uint32_t>(rem);
+	}
+
+	void clear() noexcept
+	{
+		mag_.set_size(0);
+		negative_ = false;
+	}
+
+	void swap(bigint& other) noexcept
+	{
+		std::swap(mag_, other.mag_);
+		std::swap(negative_, other.negative_);
+	}
+
+	// ---------------- 运算符 ----------------
+
+	[[nodiscard]] bigint operator-() const&
+	{
+		bigint r = *this;
+		r.negative_ = !r.negative_ && !r.is_zero();
+		return r;
+	}
+
+	[[nodiscard]] bigint operator-() &&
+	{
+		negative_ = !negative_ && !is_zero();
+		return std::move(*this);
+	}
+
+	[[nodiscard]] bigint operator+() const&
+	{
+		return *this;
+	}
+
+	bigint& operator+=(const bigint& b)
+	{
+		if(this == &b) return mul_small(2);
+		add_magnitude(b.mag_.data(), b.mag_.size(), b.negative_);
+		return *this;
+	}
+
+	bigint& operator-=(const bigint& b)
+	{
+		if(this == &b)
+		{
+			clear();
+			return *this;
+		}
+		add_magnitude(b.mag_.data(), b.mag_.size(), !b.negative_);
+		return *this;
+	}
+
+	bigint& operator*=(const bigint& b)
+	{
+		return assign_product(*this, b);
+	}
+
+	/** @throws std::domain_error b == 0 */
+	bigint& operator/=(const bigint& b)
+	{
+		bigint q, r;
+		divide(*this, b, &q, &r);
+		return *this = std::move(q);
+	}
+
+	/** @throws std::domain_error b == 0 */
+	bigint& operator%=(const bigint& b)
+	{
+		bigint q, r;
+		divide(*this, b, &q, &r);
+		return *this = std::move(r);
+	}
+
+	bigint& operator<<=(size_t bits)
+	{
+		if(is_zero() || bits == 0) return *this;
+		const size_t words = bits / 32;
+		const unsigned shift = bits % 32;
+		const size_t n = mag_.size();
+		mag_.resize(n + words + 1);
+		limb* d = mag_.data();
+		d[n + words] = 0;
+		for(size_t i = n; i-- > 0;)
+		{
+			const limb v = d[i];
+			if(shift) d[i + words + 1] |= v >> (32 - shift);
+			d[i + words] = shift ? v << shift : v;
+		}
+		std::fill_n(d, words, limb {0});
+		mag_.trim();
+		return *this;
+	}
+
+	bigint& operator>>=(size_t bits)
+	{
+		const size_t words = bits / 32;
+		const unsigned shift = bits % 32;
+		const size_t n = mag_.size();
+		if(words >= n)
+		{
+			clear();
+			return *this;
+		}
+		limb* d = mag_.data();
+		for(size_t i = 0; i + words < n; ++i)
+		{
+			limb v = d[i + words] >> shift;
+			if(shift && i + words + 1 < n) v |= d[i + words + 1] << (32 - shift);
+			d[i] = v;
+		}
+		mag_.set_size(n - words);
+		normalize();
+		return *this;
+	}
+
+	bigint& operator++()
+	{
+		return *this += 1;
+	}
+
+	bigint& operator--()
+	{
+		return *this -= 1;
+	}
+
+	[[nodiscard]] friend bigint operator+(bigint a, const bigint& b)
+	{
+		return a += b;
+	}
+	[[nodiscard]] friend bigint operator-(bigint a, const bigint& b)
+	{
+		return a -= b;
+	}
+	[[nodiscard]] friend bigint operator*(const bigint& a, const bigint& b)
+	{
+		bigint r;
+		r.assign_product(a, b);
+		return r;
+	}
+	[[nodiscard]] friend bigint operator/(const bigint& a, const bigint& b)
+	{
+		bigint q;
+		divide(a, b, &q, nullptr);
+		return q;
+	}
+	[[nodiscard]] friend bigint operator%(const bigint& a, const bigint& b)
+	{
+		bigint r;
+		divide(a, b, nullptr, &r);
+		return r;
+	}
+	[[nodiscard]] friend bigint operator<<(bigint a, size_t bits)
+	{
+		return a <<= bits;
+	}
+	[[nodiscard]] friend bigint operator>>(bigint a, size_t bits)
+	{
+		return a >>= bits;
+	}
+
+	[[nodiscard]] friend bool operator==(const bigint& a, const bigint& b) noexcept
+	{
+		return a.negative_ == b.negative_ &&
+		       bigint_details::compare(a.mag_.data(), a.mag_.size(), b.mag_.data(), b.mag_.size()) == 0;
+	}
+
+	[[nodiscard]] friend std::strong_ordering operator<=>(const bigint& a, const bigint& b) noexcept
+	{
+		if(a.negative_ != b.negative_)
+			return a.negative_ ? std::strong_ordering::less : std::strong_ordering::greater;
+		int c = bigint_details::compare(a.mag_.data(), a.mag_.size(), b.mag_.data(), b.mag_.size());
+		if(a.negative_) c = -c;
+		return c < 0 ? std::strong_ordering::less : (c > 0 ? std::strong_ordering::greater : std::strong_ordering::equal);
+	}
+
+	/**
+	 * @brief 同时求商与余数 (向零截断)
+	 * @throws std::domain_error b == 0
+	 */
+	[[nodiscard]] friend std::pair<bigint, bigint> divmod(const bigint& a, const bigint& b)
+	{
+		std::pair<bigint, bigint> qr;
+		divide(a, b, &qr.first, &qr.second);
+		return qr;
+	}
+
+	[[nodiscard]] friend bigint abs(bigint a) noexcept
+	{
+		a.negative_ = false;
+		return a;
+	}
+
+	/** @brief 十进制表示，大数按分治转换 */
+	[[nodiscard]] std::string to_string() const
+	{
+		if(is_zero()) return "0";
+		std::string out;
+		if(negative_) out.push_back('-');
+		bigint x = abs(*this);
+		if(x.mag_.size() <= bigint_details::decimal_threshold)
+		{
+			write_small(x, 0, out);
+			return out;
+		}
+		size_t k = 0;
+		while(pow10_block(k + 1) <= x) ++k;
+		write_decimal(x, k, false, out);
+		return out;
+	}
+
+	friend std::ostream& operator<<(std::ostream& os, const bigint& x)
+	{
+		return os << x.to_string();
+	}
+
+private:
+	using LimbBuffer = bigint_details::LimbBuffer;
+	using dlimb = bigint_details::dlimb;
+
+	/** @brief 绝对值，低位在前且无高位 0 */
+	LimbBuffer mag_;
+	/** @brief 0 总是非负 */
+	bool negative_ = false;
+
+	void normalize() noexcept
+	{
+		mag_.trim();
+		if(mag_.size() == 0) negative_ = false;
+	}
+
+	void set_magnitude(const limb* p, size_t n, bool negative)
+	{
+		mag_.assign(p, n);
+		negative_ = negative;
+		normalize();
+	}
+
+	[[nodiscard]] static bigint from_limbs(const limb* p, size_t n)
+	{
+		bigint r;
+		r.set_magnitude(p, n, false);
+		return r;
+	}
+
+	/** @brief β^k */
+	[[nodiscard]] static bigint limb_power(size_t k)
+	{
+		bigint r;
+		r.mag_.resize(k + 1);
+		r.mag_.data()[k] = 1;
+		return r;
+	}
+
+	void shift_limbs_left(size_t k)
+	{
+		if(is_zero() || k == 0) return;
+		const size_t n = mag_.size();
+		mag_.resize(n + k);
+		limb* d = mag_.data();
+		std::memmove(d + k, d, n * sizeof(limb));
+		std::fill_n(d, k, limb {0});
+	}
+
+	/** @brief 绝对值右移 k 个 limb (向零截断) */
+	void shift_limbs_right(size_t k)
+	{
+		const size_t n = mag_.size();
+		if(k >= n)
+		{
+			clear();
+			return;
+		}
+		limb* d = mag_.data();
+		std::memmove(d, d + k, (n - k) * sizeof(limb));
+		mag_.set_size(n - k);
+	}
+
+	/** @brief *this += (negative ? -1 : 1) * |b|，b 不得指向自身的存储 */
+	void add_magnitude(const limb* b, size_t bn, bool negative)
+	{
+		const size_t an = mag_.size();
+		if(bn == 0) return;
+		if(an == 0)
+		{
+			set_magnitude(b, bn, negative);
+			return;
+		}
+		if(negative_ == negative)
+		{
+			const size_t n = std::max(an, bn) + 1;
+			mag_.resize(n);
+			limb* d = mag_.data();
+			d[n - 1] = an >= bn ? bigint_details::add(d, d, an, b, bn) : bigint_details::add(d, b, bn, d, an);
+			normalize();
+			return;
+		}
+		const int c = bigint_details::compare(mag_.data(), an, b, bn);
+		if(c == 0)
+		{
+			clear();
+			return;
+		}
+		if(c > 0)
+		{
+			bigint_details::sub(mag_.data(), mag_.data(), an, b, bn);
+		}
+		else
+		{
+			mag_.resize(bn);
+			bigint_details::sub(mag_.data(), b, bn, mag_.data(), an);
+			negative_ = negative;
+		}
+		normalize();
+	}
+
+	/** @brief |a| / |b|，|b| 单 limb */
+	static void divide_small(const bigint& a, limb d, bigint& q, bigint& r)
+	{
+		q = a;
+		q.negative_ = false;
+		r = bigint(q.div_small(d));
+	}
+
+	/** @brief Knuth D：|a| = q |b| + r，要求 |b| 至少两个 limb 且 |a| >= |b| */
+	static void divide_knuth(const bigint& a, const bigint& b, bigint& q, bigint& r)
+	{
+		const size_t an = a.mag_.size(), bn = b.mag_.size();
+		const unsigned s = static_cast<unsigned>(std::countl_zero(b.mag_.data()[bn - 1]));
+		bigint_details::Scratch work(an + 1 + bn + (an - bn + 1));
+		limb* u = work.data();
+		limb* v = u + an + 1;
+		limb* qd = v + bn;
+
+		// 规范化：除数最高位为 1
+		const limb* ap = a.mag_.data();
+		const limb* bp = b.mag_.data();
+		for(size_t i = bn; i-- > 0;)
+			v[i] = (bp[i] << s) | (s && i ? bp[i - 1] >> (32 - s) : 0);
+		u[an] = s ? ap[an - 1] >> (32 - s) : 0;
+		for(size_t i = an; i-- > 0;)
+			u[i] = (ap[i] << s) | (s && i ? ap[i - 1] >> (32 - s) : 0);
+
+		const dlimb top = v[bn - 1], second = v[bn - 2];
+		for(size_t j = an - bn + 1; j-- > 0;)
+		{
+			const dlimb num = (dlimb {u[j + bn]} << 32) | u[j + bn - 1];
+			dlimb qhat = num / top, rhat = num % top;
+			while(qhat >> 32 || qhat * second > ((rhat << 32) | u[j + bn - 2]))
+			{
+				--qhat;
+				rhat += top;
+				if(rhat >> 32) break;
+			}
+			const limb borrow = bigint_details::submul_1(u + j, v, bn, static_cast<limb>(qhat));
+			const bool negative = u[j + bn] < borrow;
+			u[j + bn] -= borrow;
+			if(negative)
+			{
+				// qhat 大了 1：加回一个除数
+				--qhat;
+				u[j + bn] += bigint_details::add(u + j, u + j, bn, v, bn);
+			}
+			qd[j] = static_cast<limb>(qhat);
+		}
+
+		q.set_magnitude(qd, an - bn + 1, false);
+		for(size_t i = 0; i < bn; ++i)
+			u[i] = (u[i] >> s) | (s ? u[i + 1] << (32 - s) : 0);
+		r.set_magnitude(u, bn, false);
+	}
+
+	/**
+	 * @brief floor(β^(2n) / B)，B 为 n 个 limb 且最高位为 1
+	 * @note 先对 B 的高半部分递归求倒数，再做一次 Newton 迭代 X += X (β^(2n) - BX) / β^(2n)，
+	 *       误差只剩常数个单位，最后用余数精确修正
+	 */
+	[[nodiscard]] static bigint reciprocal(const bigint& B)
+	{
+		const size_t n = B.mag_.size();
+		if(n < bigint_details::newton_threshold)
+		{
+			bigint q;
+			divide(limb_power(2 * n), B, &q, nullptr);
+			return q;
+		}
+		const size_t h = (n + 1) / 2;
+		bigint X = reciprocal(from_limbs(B.mag_.data() + (n - h), h));
+		X.shift_limbs_left(n - h);
+
+		// E 的量级约为 β^(n+1)，更新 X 后用 E - B T 代替重新计算 β^(2n) - B X
+		bigint E = limb_power(2 * n) - B * X;
+		bigint T = X * E;
+		T.shift_limbs_right(2 * n);
+		X += T;
+		E -= B * T;
+
+		while(E.negative_)
+		{
+			--X;
+			E += B;
+		}
+		while(E >= B)
+		{
+			++X;
+			E -= B;
+		}
+		return X;
+	}
+
+	using Divisor = bigint_details::PreparedDivisor<bigint>;
+
+	/** @brief 规范化除数并求倒数 */
+	[[nodiscard]] static Divisor prepare(const bigint& b)
+	{
+		Divisor d;
+		d.shift = static_cast<unsigned>(std::countl_zero(b.mag_.data()[b.mag_.size() - 1]));
+		d.normalized = abs(b) << d.shift;
+		d.reciprocal = reciprocal(d.normalized);
+		return d;
+	}
+
+	/**
+	 * @brief Barrett 除法：|a| = q |b| + r，以 β^n 为一位做长除法，每位用倒数估商
+	 */
+	static void divide_newton(const bigint& a, const Divisor& d, bigint& q, bigint& r)
+	{
+		const bigint& B = d.normalized;
+		const bigint& R = d.reciprocal;
+		const size_t n = B.mag_.size();
+		const bigint A = abs(a) << d.shift;
+
+		const size_t al = A.mag_.size();
+		const size_t digits = (al + n - 1) / n;
+		LimbBuffer quotient;
+		quotient.resize(digits * n);
+
+		bigint rem, qd;
+		for(size_t c = digits; c-- > 0;)
+		{
+			const size_t lo = c * n;
+			bigint cur = rem;
+			cur.shift_limbs_left(n);
+			cur += from_limbs(A.mag_.data() + lo, std::min(n, al - lo));
+
+			// cur < B β^n；只用 cur 的高 n + 1 个 limb 估商，估值不大于真实的商且至多小 2
+			const size_t cn = cur.mag_.size();
+			if(cn >= n)
+			{
+				bigint_details::Scratch work(cn - n + 1 + R.mag_.size());
+				bigint_details::mul(work.data(), cur.mag_.data() + (n - 1), cn - n + 1, R.mag_.data(), R.mag_.size());
+				const size_t pn = cn - n + 1 + R.mag_.size();
+				qd.set_magnitude(work.data() + std::min(pn, n + 1), pn - std::min(pn, n + 1), false);
+			}
+			else
+			{
+				qd.clear();
+			}
+			rem = cur - qd * B;
+			while(rem >= B)
+			{
+				rem -= B;
+				++qd;
+			}
+			std::copy_n(qd.mag_.data(), qd.mag_.size(), quotient.data() + lo);
+		}
+		q.mag_ = std::move(quotient);
+		q.negative_ = false;
+		q.normalize();
+		r = std::move(rem) >> d.shift;
+	}
+
+	/**
+	 * @brief 向零截断的除法；q, r 可以为空，也可以与 a, b 重合
+	 */
+	static void divide(const bigint& a, const bigint& b, bigint* q, bigint* r)
+	{
+		if(b.is_zero()) [[unlikely]]
+			throw std::domain_error("hyx::bigint: Division by zero.");
+
+		const bool qneg = a.negative_ != b.negative_;
+		const bool rneg = a.negative_;
+		bigint qm, rm;
+		const size_t an = a.mag_.size(), bn = b.mag_.size();
+		if(bigint_details::compare(a.mag_.data(), an, b.mag_.data(), bn) < 0)
+			rm = abs(a);
+		else if(bn == 1)
+			divide_small(a, b.mag_.data()[0], qm, rm);
+		else if(bn < bigint_details::newton_threshold || an - bn < bigint_details::newton_threshold)
+			divide_knuth(a, b, qm, rm);
+		else
+			divide_newton(a, prepare(b), qm, rm);
+
+		qm.negative_ = qneg && !qm.is_zero();
+		rm.negative_ = rneg && !rm.is_zero();
+		if(q) *q = std::move(qm);
+		if(r) *r = std::move(rm);
+	}
+
+	/** @brief 10^(9 * 2^k)，线程局部缓存 */
+	[[nodiscard]] static const bigint& pow10_block(size_t k)
+	{
+		thread_local std::deque<bigint> powers;
+		if(powers.empty()) powers.emplace_back(1000000000u);
+		while(powers.size() <= k)
+			powers.push_back(powers.back() * powers.back());
+		return powers[k];
+	}
+
+	/** @brief 10^(9 * 2^k) 的预计算除数，线程局部缓存 */
+	[[nodiscard]] static const Divisor& pow10_divisor(size_t k)
+	{
+		thread_local std::deque<Divisor> divisors;
+		while(divisors.size() <= k)
+			divisors.push_back(prepare(pow10_block(divisors.size())));
+		return divisors[k];
+	}
+
+	/** @brief 逐 10^9 取余，width > 0 时左侧补 0 到该宽度 */
+	static void write_small(bigint x, size_t width, std::string& out)
+	{
+		std::vector<std::uint32_t> chunks;
+		while(!x.is_zero())
+			chunks.push_back(x.div_small(1000000000u));
+		std::string digits;
+		for(size_t i = chunks.size(); i-- > 0;)
+		{
+			const std::string part = std::to_string(chunks[i]);
+			if(i + 1 < chunks.size()) digits.append(9 - part.size(), '0');
+			digits += part;
+		}
+		if(digits.empty()) digits = "0";
+		if(width > digits.size()) out.append(width - digits.size(), '0');
+		out += digits;
+	}
+
+	/**
+	 * @brief 分治转换：x < 10^(9 * 2^(k+1))；pad 时恰好输出 9 * 2^(k+1) 位
+	 */
+	static void write_decimal(const bigint& x, size_t k, bool pad, std::string& out)
+	{
+		const size_t width = pad ? 9 * (size_t {2} << k) : 0;
+		if(k == 0 || x.mag_.size() <= bigint_details::decimal_threshold)
+		{
+			write_small(x, width, out);
+			return;
+		}
+		const bigint& p = pow10_block(k);
+		if(!pad && x < p)
+		{
+			write_decimal(x, k - 1, false, out);
+			return;
+		}
+		bigint hi, lo;
+		if(p.mag_.size() < bigint_details::newton_threshold || x.mag_.size() - p.mag_.size() < bigint_details::newton_threshold)
+			divide(x, p, &hi, &lo);
+		else
+			divide_newton(x, pow10_divisor(k), hi, lo);
+		write_decimal(hi, k - 1, pad, out);
+		write_decimal(lo, k - 1, true, out);
+	}
+
+	/** @brief 分治解析纯数字串 */
+	[[nodiscard]] static bigint parse_digits(std::string_view s)
+	{
+		if(s.size() <= 9 * bigint_details::decimal_threshold)
+		{
+			bigint x;
+			size_t i = 0;
+			const size_t head = s.size() % 9;
+			auto chunk = [&](size_t len)
+			{
+				std::uint32_t v = 0, scale = 1;
+				for(size_t j = 0; j < len; ++j, ++i)
+				{
+					v = v * 10 + static_cast<std::uint32_t>(s[i] - '0');
+					scale *= 10;
+				}
+				x.mul_small(scale);
+				x += bigint(v);
+			};
+			if(head) chunk(head);
+			while(i < s.size()) chunk(9);
+			return x;
+		}
+		size_t k = 0;
+		while(9 * (size_t {2} << k) < s.size()) ++k;
+		const size_t low = 9 * (size_t {1} << k);
+		bigint x = parse_digits(s.substr(0, s.size() - low));
+		x.assign_product(x, pow10_block(k));
+		x += parse_digits(s.substr(s.size() - low));
+		return x;
+	}
+};
+
+/**
+ * @brief base^e
+ */
+[[nodiscard]] inline bigint pow(bigint base, std::uint64_t e)
+{
+	bigint r = 1;
+	for(; e; e >>= 1)
+	{
+		if(e & 1) r *= base;
+		if(e > 1) base *= base;
+	}
+	return r;
+}
+
+} // namespace hyx
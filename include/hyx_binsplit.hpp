@@ -0,0 +1,267 @@
+#pragma once
+
+#include <version>
+#if __cplusplus < 202302L
+#error "hyx_binsplit.hpp requires C++23 or later."
+#endif
+
+/**
+ * @file hyx_binsplit.hpp
+ * @brief 超几何型级数部分和的二分求值 (binary splitting)
+ * @note 级数写成 S(N) = Σ_{n<N} a(n)/b(n) · Π_{1<=k<=n} p(k)/q(k)，p, q, a, b 为整系数多项式 (或任意整数值函数)。
+ *       对区间 [n1, n2) 维护 P = Πp，Q = Πq，B = Πb 与 T = B·Q·S，两半合并只需几次大整数乘法，
+ *       配合 hyx::bigint 的 NTT 乘法总代价为 O(M(N log N) log N)。递归树的上层在多个线程上并行展开
+ *
+ * @version 1.0.0
+ * @author Heylyx841
+ * @date 2026-10-18
+ * @license MIT License
+ */
+
+#include "hyx_bigint.hpp"
+
+#include <cstdint>      // std::uint64_t
+#include <cstddef>      // size_t
+#include <bit>          // std::bit_width
+#include <thread>       // std::jthread, std::thread::hardware_concurrency
+#include <exception>    // std::exception_ptr, std::current_exception, std::rethrow_exception
+#include <system_error> // std::system_error
+#include <functional>   // std::invoke
+#include <string>       // std::string
+#include <utility>      // std::move
+#include <algorithm>    // std::max
+#include <concepts>     // std::constructible_from
+#include <type_traits>  // std::is_same_v, std::invoke_result_t
+#include <stdexcept>    // std::domain_error
+
+/**
+ * @namespace hyx
+ */
+namespace hyx
+{
+
+/**
+ * @struct fraction
+ * @brief 未约分的精确分数 num / den，den > 0
+ */
+struct fraction
+{
+	bigint num;
+	bigint den = 1;
+
+	/**
+	 * @brief 截断到小数点后 digits 位的十进制表示
+	 * @throws std::domain_error den == 0
+	 */
+	[[nodiscard]] std::string to_decimal(size_t digits) const
+	{
+		const bigint scaled = abs(num) * pow(bigint(10), digits) / den;
+		std::string s = scaled.to_string();
+		if(s.size() <= digits) s.insert(0, digits + 1 - s.size(), '0');
+		if(digits > 0) s.insert(s.size() - digits, 1, '.');
+		if(num.sign() < 0) s.insert(0, 1, '-');
+		return s;
+	}
+};
+
+/**
+ * @struct binsplit_options
+ * @brief 二分求值选项
+ */
+struct binsplit_options
+{
+	/** @brief 参与计算的线程数 (含调用线程)，0 表示 hardware_concurrency */
+	size_t threads = 0;
+	/** @brief 区间短于该长度时不再分派到新线程 */
+	std::uint64_t parallel_grain = 256;
+};
+
+/**
+ * @namespace binsplit_details
+ * @brief 内部实现细节
+ */
+namespace binsplit_details
+{
+
+/** @brief 恒为 1 的因子，省去对应的乘法 */
+struct One
+{
+	[[nodiscard]] constexpr int operator()(std::uint64_t) const noexcept
+	{
+		return 1;
+	}
+};
+
+template <typename F>
+concept integer_valued = std::is_invocable_v<const F&, std::uint64_t> &&
+                         std::constructible_from<bigint, std::invoke_result_t<const F&, std::uint64_t>>;
+
+/**
+ * @struct Node
+ * @brief 区间 [n1, n2) 的状态：P = Πp，Q = Πq，B = Πb，T = B·Q·S
+ */
+struct Node
+{
+	bigint P = 1, Q = 1, B = 1, T;
+};
+
+} // namespace binsplit_details
+
+/**
+ * @class hypergeometric_sum
+ * @brief 超几何型级数的部分和
+ * @note 第 0 项为 a(0)/b(0)，之后每项是前一项乘以 p(n)/q(n) 再换用 a(n)/b(n)；p(0), q(0) 不参与计算。
+ *       已求出的前缀状态会保留，sum(N) 对更大的 N 只计算新增的区间再与前缀合并。
+ *       非线程安全：同一对象的调用需要外部同步
+ *
+ * @tparam P, Q 项比的分子 / 分母，可用整数或 bigint 表示的 f(n)
+ * @tparam A, B 非超几何部分 a(n)/b(n)，默认为 1
+ */
+template <typename P, typename Q, typename A = binsplit_details::One, typename B = binsplit_details::One>
+requires binsplit_details::integer_valued<P> && binsplit_details::integer_valued<Q> &&
+         binsplit_details::integer_valued<A> && binsplit_details::integer_valued<B>
+class hypergeometric_sum
+{
+public:
+	explicit hypergeometric_sum(P p, Q q, A a = {}, B b = {}, binsplit_options options = {})
+		: p_(std::move(p)), q_(std::move(q)), a_(std::move(a)), b_(std::move(b)), options_(options)
+	{
+		if(options_.threads == 0) options_.threads = std::max(1u, std::thread::hardware_concurrency());
+		options_.parallel_grain = std::max<std::uint64_t>(2, options_.parallel_grain);
+	}
+
+	/**
+	 * @brief 前 N 项之和 Σ_{n<N}，精确分数 (未约分)
+	 * @throws std::domain_error 某个 q(n) 或 b(n) 为 0
+	 * @note N 不小于已缓存的长度时扩展缓存；否则单独计算，不影响缓存
+	 */
+	[[nodiscard]] fraction sum(std::uint64_t N)
+	{
+		if(N == 0) return {};
+		if(N < terms_) return finish(split(0, N, spawn_depth()));
+		if(N > terms_)
+		{
+			binsplit_details::Node block = split(terms_, N, spawn_depth());
+			prefix_ = terms_ == 0 ? std::move(block) : merge(prefix_, block);
+			terms_ = N;
+		}
+		return finish(prefix_);
+	}
+
+	/** @brief 已缓存的前缀项数 */
+	[[nodiscard]] std::uint64_t terms() const noexcept
+	{
+		return terms_;
+	}
+
+private:
+	using Node = binsplit_details::Node;
+
+	static constexpr bool unit_a = std::is_same_v<A, binsplit_details::One>;
+	static constexpr bool unit_b = std::is_same_v<B, binsplit_details::One>;
+
+	P p_;
+	Q q_;
+	A a_;
+	B b_;
+	binsplit_options options_;
+	std::uint64_t terms_ = 0;
+	Node prefix_;
+
+	/** @brief 递归树前若干层分派到新线程，使叶子层的并行度约为 threads */
+	[[nodiscard]] unsigned spawn_depth() const noexcept
+	{
+		return static_cast<unsigned>(std::bit_width(options_.threads - 1));
+	}
+
+	[[nodiscard]] Node leaf(std::uint64_t n) const
+	{
+		Node node;
+		if(n > 0)
+		{
+			node.P = bigint(std::invoke(p_, n));
+			node.Q = bigint(std::invoke(q_, n));
+			if(node.Q.is_zero()) [[unlikely]]
+				throw std::domain_error("hyx::hypergeometric_sum: q(n) is zero.");
+		}
+		if constexpr(!unit_b)
+		{
+			node.B = bigint(std::invoke(b_, n));
+			if(node.B.is_zero()) [[unlikely]]
+				throw std::domain_error("hyx::hypergeometric_sum: b(n) is zero.");
+		}
+		if constexpr(unit_a)
+			node.T = node.P;
+		else
+			node.T = bigint(std::invoke(a_, n)) * node.P;
+		return node;
+	}
+
+	/**
+	 * @brief 合并相邻区间：S = S_l + (P_l / Q_l) S_r
+	 * @note T = B_r Q_r T_l + B_l P_l T_r
+	 */
+	[[nodiscard]] static Node merge(const Node& l, const Node& r)
+	{
+		Node m;
+		m.T = r.Q * l.T;
+		if constexpr(!unit_b) m.T *= r.B;
+		bigint tail = l.P * r.T;
+		if constexpr(!unit_b) tail *= l.B;
+		m.T += tail;
+		m.P = l.P * r.P;
+		m.Q = l.Q * r.Q;
+		if constexpr(!unit_b) m.B = l.B * r.B;
+		return m;
+	}
+
+	[[nodiscard]] Node split(std::uint64_t n1, std::uint64_t n2, unsigned depth) const
+	{
+		if(n2 - n1 == 1) return leaf(n1);
+		const std::uint64_t mid = n1 + (n2 - n1) / 2;
+		if(depth > 0 && n2 - n1 >= options_.parallel_grain)
+		{
+			Node left;
+			std::exception_ptr error;
+			std::jthread worker;
+			try
+			{
+				worker = std::jthread([&]
+				{
+					try
+					{
+						left = split(n1, mid, depth - 1);
+					}
+					catch(...)
+					{
+						error = std::current_exception();
+					}
+				});
+			}
+			catch(const std::system_error&)
+			{
+				// 无法创建线程时退回单线程
+				return merge(split(n1, mid, 0), split(mid, n2, 0));
+			}
+			Node right = split(mid, n2, depth - 1);
+			worker.join();
+			if(error) std::rethrow_exception(error);
+			return merge(left, right);
+		}
+		return merge(split(n1, mid, 0), split(mid, n2, 0));
+	}
+
+	[[nodiscard]] static fraction finish(const Node& node)
+	{
+		fraction f {node.T, node.Q};
+		if constexpr(!unit_b) f.den *= node.B;
+		if(f.den.sign() < 0)
+		{
+			f.num = -std::move(f.num);
+			f.den = -std::move(f.den);
+		}
+		return f;
+	}
+};
+
+} // namespace hyx
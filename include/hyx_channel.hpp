@@ -0,0 +1,354 @@
+#pragma once
+
+#include <version>
+#if __cplusplus < 202302L
+#error "hyx_channel.hpp requires C++23 or later."
+#endif
+
+/**
+ * @file hyx_channel.hpp
+ * @brief 生成线程到消费线程的有界数列通道
+ * @note 专用的生成线程按块扩展内部的 autoseq，并把每块复制进环形缓冲区的一个槽位；
+ *       消费者按顺序取得槽位的只读视图，不再复制。环满时生成线程等待最慢的消费者 (背压)。
+ *       发布与释放只使用原子计数，阻塞时通过 std::atomic::wait 休眠
+ *
+ * @version 1.0.0
+ * @author Heylyx841
+ * @date 2026-10-18
+ * @license MIT License
+ */
+
+#include "hyx_autoseq.hpp"
+
+#include <vector>       // std::vector
+#include <atomic>       // std::atomic
+#include <thread>       // std::jthread
+#include <stop_token>   // std::stop_token
+#include <exception>    // std::exception_ptr, std::current_exception, std::rethrow_exception
+#include <optional>     // std::optional
+#include <memory>       // std::unique_ptr, std::make_unique
+#include <span>         // std::span
+#include <limits>       // std::numeric_limits
+#include <algorithm>    // std::min, std::max
+#include <cstddef>      // size_t
+#include <utility>      // std::forward, std::move, std::exchange
+#include <stdexcept>    // std::invalid_argument, std::logic_error
+
+/**
+ * @namespace hyx
+ */
+namespace hyx
+{
+
+/**
+ * @struct channel_options
+ * @brief 数列通道选项
+ */
+struct channel_options
+{
+	/** @brief 每块的项数 */
+	size_t block_terms = 4096;
+	/** @brief 环形缓冲区的块数，生成线程最多领先最慢的消费者这么多块 */
+	size_t blocks = 8;
+	/** @brief 消费者数：1 为单消费者，大于 1 时每个消费者都收到全部块 (广播) */
+	size_t consumers = 1;
+	/** @brief 常驻前缀的项数，生成后一直保留，可随时通过 prefix() 读取 */
+	size_t prefix = 0;
+	/** @brief 总项数上限，默认不限 */
+	size_t limit = std::numeric_limits<size_t>::max();
+	/**
+	 * @brief 公式能力；声明有限的 lookback 或 history_free 时，生成线程在每块之后释放不再回看的历史，
+	 *        内存占用与已生成的项数无关
+	 */
+	autoseq_caps caps {};
+};
+
+/**
+ * @struct channel_block
+ * @brief 消费者取得的一块：第 first 项起的连续项
+ */
+template <typename T>
+struct channel_block
+{
+	size_t first;
+	std::span<const T> terms;
+};
+
+/**
+ * @class seq_channel
+ * @brief 一个生成线程、若干消费线程的有界数列通道
+ * @note 构造后生成线程立即开始填充环形缓冲区。每个消费者通过 open(i) 取得一次读端；
+ *       未打开的读端同样参与背压，关闭 (析构) 的读端不再阻挡生成线程。
+ *       读端必须在通道析构前销毁
+ */
+template <typename T, typename Alloc = std::allocator<T>>
+class seq_channel
+{
+	struct alignas(64) Cursor
+	{
+		/** @brief 已释放的块数 */
+		std::atomic<size_t> released {0};
+		bool opened = false;
+	};
+
+public:
+	/**
+	 * @class reader
+	 * @brief 读端：按顺序取得各块的只读视图
+	 * @note 视图在下一次 next() 或 release() 之前有效；每个读端只能由一个线程使用
+	 */
+	class reader
+	{
+	public:
+		reader(reader&& other) noexcept
+			: channel_(std::exchange(other.channel_, nullptr)), index_(other.index_), next_(other.next_), holding_(other.holding_)
+		{
+		}
+
+		reader& operator=(reader&& other) noexcept
+		{
+			if(this != &other)
+			{
+				close();
+				channel_ = std::exchange(other.channel_, nullptr);
+				index_ = other.index_;
+				next_ = other.next_;
+				holding_ = other.holding_;
+			}
+			return *this;
+		}
+
+		~reader()
+		{
+			close();
+		}
+
+		/**
+		 * @brief 释放当前块并等待下一块
+		 * @return 下一块；生成结束 (达到 limit 或通道停止) 时为空
+		 * @throws 生成线程中公式抛出的异常，在已发布的块全部取完之后抛出
+		 */
+		[[nodiscard]] std::optional<channel_block<T>> next()
+		{
+			release();
+			auto& ch = *channel_;
+			while(true)
+			{
+				const size_t events = ch.events_.load(std::memory_order_acquire);
+				// 先读 finished_ 再读 published_：结束时看到的必然是最终发布数
+				const bool finished = ch.finished_.load(std::memory_order_acquire);
+				if(ch.published_.load(std::memory_order_acquire) > next_) break;
+				if(finished)
+				{
+					if(ch.error_) std::rethrow_exception(ch.error_);
+					return std::nullopt;
+				}
+				ch.events_.wait(events, std::memory_order_acquire);
+			}
+			holding_ = true;
+			const auto& slot = ch.slots_[next_ % ch.slots_.size()];
+			return channel_block<T> {next_ * ch.options_.block_terms, std::span<const T>(slot)};
+		}
+
+		/** @brief 提前释放当前块，让生成线程可以复用它的槽位 */
+		void release() noexcept
+		{
+			if(!holding_) return;
+			holding_ = false;
+			channel_->cursors_[index_].released.store(++next_, std::memory_order_release);
+			channel_->wake_producer();
+		}
+
+	private:
+		friend class seq_channel;
+
+		seq_channel* channel_;
+		size_t index_;
+		size_t next_ = 0;
+		bool holding_ = false;
+
+		reader(seq_channel& channel, size_t index) noexcept
+			: channel_(&channel), index_(index)
+		{
+		}
+
+		/** @brief 关闭后不再阻挡生成线程 */
+		void close() noexcept
+		{
+			if(!channel_) return;
+			channel_->cursors_[index_].released.store(std::numeric_limits<size_t>::max(), std::memory_order_release);
+			channel_->wake_producer();
+			channel_ = nullptr;
+		}
+	};
+
+	/**
+	 * @param options 通道选项
+	 * @param g 生成公式，与 autoseq 相同
+	 * @param init_values 初始项
+	 * @throws std::invalid_argument block_terms、blocks 或 consumers 为 0
+	 */
+	template <typename Gen, typename... InitArgs>
+	requires(std::convertible_to<InitArgs, T> && ...)
+	explicit seq_channel(const channel_options& options, Gen&& g, InitArgs&&... init_values)
+		: seq_channel(std::allocator_arg, Alloc(), options, std::forward<Gen>(g), std::forward<InitArgs>(init_values)...)
+	{
+	}
+
+	template <typename Gen, typename... InitArgs>
+	requires(std::convertible_to<InitArgs, T> && ...)
+	seq_channel(std::allocator_arg_t, const Alloc& alloc, const channel_options& options, Gen&& g, InitArgs&&... init_values)
+		: options_(options)
+		, seq_(std::allocator_arg, alloc, std::forward<Gen>(g), std::forward<InitArgs>(init_values)...)
+		, prefix_(alloc)
+	{
+		if(options_.block_terms == 0 || options_.blocks == 0 || options_.consumers == 0) [[unlikely]]
+			throw std::invalid_argument("hyx::seq_channel: block_terms, blocks and consumers must be positive.");
+
+		seq_.set_caps(options_.caps);
+		slots_.assign(options_.blocks, std::vector<T, Alloc>(alloc));
+		cursors_ = std::make_unique<Cursor[]>(options_.consumers);
+		prefix_limit_ = std::min(options_.prefix, options_.limit);
+		prefix_.reserve(prefix_limit_);
+		prefix_data_ = prefix_.data();
+		producer_ = std::jthread([this](std::stop_token stop) { produce(stop); });
+	}
+
+	seq_channel(const seq_channel&) = delete;
+	seq_channel& operator=(const seq_channel&) = delete;
+
+	/** @brief 停止生成线程并等待其退出 */
+	~seq_channel()
+	{
+		producer_.request_stop();
+		wake_producer();
+	}
+
+	/**
+	 * @brief 打开第 i 个读端
+	 * @throws std::invalid_argument i >= consumers
+	 * @throws std::logic_error 该读端已经打开过
+	 */
+	[[nodiscard]] reader open(size_t i = 0)
+	{
+		if(i >= options_.consumers) [[unlikely]]
+			throw std::invalid_argument("hyx::seq_channel: Consumer index out of range.");
+		if(std::exchange(cursors_[i].opened, true)) [[unlikely]]
+			throw std::logic_error("hyx::seq_channel: Consumer already opened.");
+		return reader(*this, i);
+	}
+
+	/**
+	 * @brief 已生成的常驻前缀，长度不超过 options.prefix
+	 * @note 可在任意线程读取；前缀项生成后不再改变
+	 */
+	[[nodiscard]] std::span<const T> prefix() const noexcept
+	{
+		return {prefix_data_, prefix_ready_.load(std::memory_order_acquire)};
+	}
+
+	/** @brief 已发布的块数 */
+	[[nodiscard]] size_t published() const noexcept
+	{
+		return published_.load(std::memory_order_acquire);
+	}
+
+	[[nodiscard]] const channel_options& options() const noexcept
+	{
+		return options_;
+	}
+
+private:
+	channel_options options_;
+	autoseq<T, Alloc> seq_;
+	std::vector<std::vector<T, Alloc>> slots_;
+	std::unique_ptr<Cursor[]> cursors_;
+	/** @brief 只由生成线程追加；容量预先分配，追加时数据地址不变 */
+	std::vector<T, Alloc> prefix_;
+	/** @brief 常驻前缀的项数上限；reserve 可能多分配，不能以 capacity() 为准 */
+	size_t prefix_limit_ = 0;
+	const T* prefix_data_ = nullptr;
+	std::atomic<size_t> prefix_ready_ {0};
+
+	/** @brief 已发布的块数 */
+	alignas(64) std::atomic<size_t> published_ {0};
+	/** @brief 发布或结束时递增，消费者在其上等待 */
+	std::atomic<size_t> events_ {0};
+	std::atomic<bool> finished_ {false};
+	std::exception_ptr error_;
+
+	/** @brief 读端释放或关闭时递增，生成线程在其上等待 */
+	alignas(64) std::atomic<size_t> releases_ {0};
+
+	/** @brief 最后声明，析构时最先停止并汇合，此时其它成员仍然有效 */
+	std::jthread producer_;
+
+	void wake_producer() noexcept
+	{
+		releases_.fetch_add(1, std::memory_order_release);
+		releases_.notify_one();
+	}
+
+	[[nodiscard]] size_t slowest() const noexcept
+	{
+		size_t least = std::numeric_limits<size_t>::max();
+		for(size_t i = 0; i < options_.consumers; ++i)
+			least = std::min(least, cursors_[i].released.load(std::memory_order_acquire));
+		return least;
+	}
+
+	/** @brief 等待槽位 k % blocks 被所有读端释放；停止或读端全部关闭时返回 false */
+	[[nodiscard]] bool wait_for_slot(size_t k, const std::stop_token& stop) const
+	{
+		while(true)
+		{
+			const size_t releases = releases_.load(std::memory_order_acquire);
+			if(stop.stop_requested()) return false;
+			const size_t least = slowest();
+			if(least == std::numeric_limits<size_t>::max()) return false;
+			if(k - std::min(k, least) < slots_.size()) return true;
+			releases_.wait(releases, std::memory_order_acquire);
+		}
+	}
+
+	void produce(std::stop_token stop)
+	{
+		const size_t block = options_.block_terms;
+		const size_t total = options_.limit == 0 ? 0 : (options_.limit - 1) / block + 1;
+		const bool bounded = options_.caps.history_free || options_.caps.lookback != std::dynamic_extent;
+		try
+		{
+			for(size_t k = 0; k < total; ++k)
+			{
+				if(!wait_for_slot(k, stop)) break;
+
+				const size_t first = k * block;
+				const size_t count = std::min(block, options_.limit - first);
+				std::span<const T> terms = seq_.slice(first, first + count);
+				slots_[k % slots_.size()].assign(terms.begin(), terms.end());
+
+				if(prefix_.size() < prefix_limit_)
+				{
+					const size_t take = std::min(prefix_limit_ - prefix_.size(), count);
+					prefix_.insert(prefix_.end(), terms.begin(), terms.begin() + static_cast<std::ptrdiff_t>(take));
+					prefix_ready_.store(prefix_.size(), std::memory_order_release);
+				}
+				if(bounded)
+					seq_.release_before(first + count);
+
+				published_.store(k + 1, std::memory_order_release);
+				events_.fetch_add(1, std::memory_order_release);
+				events_.notify_all();
+			}
+		}
+		catch(...)
+		{
+			error_ = std::current_exception();
+		}
+		finished_.store(true, std::memory_order_release);
+		events_.fetch_add(1, std::memory_order_release);
+		events_.notify_all();
+	}
+};
+
+} // namespace hyx
@@ -0,0 +1,344 @@
+#pragma once
+
+#include <version>
+#if __cplusplus < 202302L
+#error "hyx_numa.hpp requires C++23 or later."
+#endif
+
+/**
+ * @file hyx_numa.hpp
+ * @brief NUMA 感知的内存放置与只读副本
+ * @note 直接使用 mbind / get_mempolicy / getcpu 系统调用，不依赖 libnuma；
+ *       非 Linux 平台或内核拒绝策略时退化为普通分配
+ *
+ * @version 1.0.0
+ * @author Heylyx841
+ * @date 2026-10-18
+ * @license MIT License
+ */
+
+#include <array>        // std::array
+#include <vector>       // std::vector
+#include <span>         // std::span
+#include <memory>       // std::uninitialized_copy, std::destroy
+#include <new>          // std::bad_alloc, ::operator new
+#include <limits>       // std::numeric_limits
+#include <cstddef>      // size_t
+#include <type_traits>  // std::true_type
+
+#if defined(__linux__)
+#include <sys/mman.h>     // mmap, munmap
+#include <sys/syscall.h>  // SYS_mbind, SYS_get_mempolicy, SYS_getcpu
+#include <unistd.h>       // syscall, sysconf
+#endif
+
+/**
+ * @namespace hyx
+ */
+namespace hyx
+{
+
+/**
+ * @brief 内存放置策略
+ */
+enum class numa_policy
+{
+	/** @brief 内核默认策略 (首次触碰所在节点) */
+	local,
+	/** @brief 按页轮流分布到所有允许的节点 */
+	interleave,
+	/** @brief 绑定到指定节点 */
+	bind
+};
+
+/**
+ * @namespace numa_details
+ * @brief 内部实现细节
+ */
+namespace numa_details
+{
+
+// <linux/mempolicy.h> 中的常量，避免引入 libnuma 头文件
+inline constexpr int mpol_default = 0;
+inline constexpr int mpol_bind = 2;
+inline constexpr int mpol_interleave = 3;
+inline constexpr unsigned long mpol_f_mems_allowed = 1ul << 2;
+
+/** @brief 支持的最大节点数 */
+inline constexpr size_t max_nodes = 1024;
+inline constexpr size_t word_bits = std::numeric_limits<unsigned long>::digits;
+
+using node_mask = std::array<unsigned long, max_nodes / word_bits>;
+
+/** @brief 低于该字节数的分配不值得按页放置 */
+inline constexpr size_t placement_threshold = size_t{1} << 20;
+
+/**
+ * @brief 当前进程允许使用的节点集合 (只查询一次)
+ */
+inline const node_mask& allowed_nodes() noexcept
+{
+	static const node_mask mask = []
+	{
+		node_mask m{};
+#if defined(__linux__)
+		if(::syscall(SYS_get_mempolicy, nullptr, m.data(), max_nodes, nullptr, mpol_f_mems_allowed) == 0)
+			return m;
+		m = {};
+#endif
+		m[0] = 1; // 无法查询时视为单节点
+		return m;
+	}();
+	return mask;
+}
+
+/**
+ * @brief 对 [addr, addr + bytes) 设置放置策略
+ * @return 内核是否接受了该策略
+ */
+inline bool apply_policy(void* addr, size_t bytes, numa_policy policy, int node) noexcept
+{
+#if defined(__linux__)
+	node_mask mask{};
+	int mode = mpol_default;
+	switch(policy)
+	{
+	case numa_policy::local:
+		return true;
+	case numa_policy::interleave:
+		mode = mpol_interleave;
+		mask = allowed_nodes();
+		break;
+	case numa_policy::bind:
+		if(node < 0 || static_cast<size_t>(node) >= max_nodes) return false;
+		mode = mpol_bind;
+		mask[node / word_bits] = 1ul << (node % word_bits);
+		break;
+	}
+	// 内核按 maxnode - 1 位读取掩码，因此多传一位
+	return ::syscall(SYS_mbind, addr, bytes, mode, mask.data(), max_nodes + 1, 0u) == 0;
+#else
+	(void)addr, (void)bytes, (void)policy, (void)node;
+	return false;
+#endif
+}
+
+/**
+ * @brief 分配按页对齐的匿名内存并设置放置策略 (页面在首次写入时才落到节点上)
+ */
+inline void* map_pages(size_t bytes, numa_policy policy, int node)
+{
+#if defined(__linux__)
+	void* p = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if(p == MAP_FAILED) [[unlikely]]
+		throw std::bad_alloc();
+	apply_policy(p, bytes, policy, node);
+	return p;
+#else
+	(void)policy, (void)node;
+	return ::operator new(bytes);
+#endif
+}
+
+inline void unmap_pages(void* p, size_t bytes) noexcept
+{
+#if defined(__linux__)
+	::munmap(p, bytes);
+#else
+	(void)bytes;
+	::operator delete(p);
+#endif
+}
+
+} // namespace numa_details
+
+/**
+ * @brief 当前进程可用的 NUMA 节点数
+ */
+[[nodiscard]] inline size_t numa_node_count() noexcept
+{
+	size_t count = 0;
+	for(unsigned long word : numa_details::allowed_nodes())
+		count += static_cast<size_t>(__builtin_popcountl(word));
+	return count;
+}
+
+/**
+ * @brief 调用线程当前所在的 NUMA 节点
+ */
+[[nodiscard]] inline int numa_current_node() noexcept
+{
+#if defined(__linux__)
+	unsigned cpu = 0, node = 0;
+	if(::syscall(SYS_getcpu, &cpu, &node, nullptr) == 0)
+		return static_cast<int>(node);
+#endif
+	return 0;
+}
+
+/**
+ * @class numa_allocator
+ * @brief 按策略放置大块内存的分配器，可直接作为 autoseq 的 Alloc 参数
+ * @note 小于 1 MiB 的请求走普通堆分配，不设置策略
+ *
+ * @tparam T 元素类型
+ */
+template <typename T>
+class numa_allocator
+{
+public:
+	using value_type = T;
+	using propagate_on_container_move_assignment = std::true_type;
+	using is_always_equal = std::false_type;
+
+	constexpr numa_allocator() noexcept = default;
+
+	explicit constexpr numa_allocator(numa_policy policy, int node = -1) noexcept
+		: policy_(policy), node_(node) {}
+
+	template <typename U>
+	constexpr numa_allocator(const numa_allocator<U>& other) noexcept
+		: policy_(other.policy()), node_(other.node()) {}
+
+	[[nodiscard]] T* allocate(size_t n)
+	{
+		if(n > std::numeric_limits<size_t>::max() / sizeof(T)) [[unlikely]]
+			throw std::bad_array_new_length();
+
+		const size_t bytes = n * sizeof(T);
+		if(bytes < numa_details::placement_threshold)
+			return static_cast<T*>(::operator new(bytes, std::align_val_t{alignof(T)}));
+		return static_cast<T*>(numa_details::map_pages(bytes, policy_, node_));
+	}
+
+	void deallocate(T* p, size_t n) noexcept
+	{
+		const size_t bytes = n * sizeof(T);
+		if(bytes < numa_details::placement_threshold)
+			::operator delete(p, bytes, std::align_val_t{alignof(T)});
+		else
+			numa_details::unmap_pages(p, bytes);
+	}
+
+	[[nodiscard]] constexpr numa_policy policy() const noexcept
+	{
+		return policy_;
+	}
+	[[nodiscard]] constexpr int node() const noexcept
+	{
+		return node_;
+	}
+
+	template <typename U>
+	[[nodiscard]] constexpr bool operator==(const numa_allocator<U>& other) const noexcept
+	{
+		return policy_ == other.policy() && node_ == other.node();
+	}
+
+private:
+	numa_policy policy_ = numa_policy::interleave;
+	int node_ = -1;
+};
+
+/**
+ * @class numa_replica
+ * @brief 已冻结前缀的逐节点只读副本
+ * @note 每个节点持有一份绑定在本地内存上的拷贝，读线程通过 local() 访问本节点副本；
+ *       构造完成后全部成员函数均可多线程并发调用
+ *
+ * @tparam T 元素类型
+ */
+template <typename T>
+class numa_replica
+{
+public:
+	/**
+	 * @brief 为每个可用节点复制一份 data
+	 * @note 通常传入 autoseq::slice(0, n) 或 view()
+	 */
+	explicit numa_replica(std::span<const T> data)
+		: size_(data.size())
+	{
+		const auto& mask = numa_details::allowed_nodes();
+		node_index_.assign(numa_details::max_nodes, 0);
+		for(size_t node = 0; node < numa_details::max_nodes; ++node)
+		{
+			if(!(mask[node / numa_details::word_bits] >> (node % numa_details::word_bits) & 1ul))
+				continue;
+
+			node_index_[node] = replicas_.size();
+			replicas_.push_back(nullptr);
+			if(size_ == 0) continue;
+
+			// 先绑定再拷贝：页面在拷贝时首次触碰，从而落在目标节点上
+			T* p = static_cast<T*>(numa_details::map_pages(bytes(), numa_policy::bind, static_cast<int>(node)));
+			try
+			{
+				std::uninitialized_copy(data.begin(), data.end(), p);
+			}
+			catch(...)
+			{
+				numa_details::unmap_pages(p, bytes());
+				release();
+				throw;
+			}
+			replicas_.back() = p;
+		}
+	}
+
+	numa_replica(const numa_replica&) = delete;
+	numa_replica& operator=(const numa_replica&) = delete;
+
+	~numa_replica()
+	{
+		release();
+	}
+
+	/** @brief 调用线程所在节点的副本 */
+	[[nodiscard]] std::span<const T> local() const noexcept
+	{
+		const int node = numa_current_node();
+		const size_t idx = static_cast<size_t>(node) < node_index_.size() ? node_index_[node] : 0;
+		return {replicas_[idx], size_};
+	}
+
+	/** @brief 第 i 份副本 (按节点编号升序) */
+	[[nodiscard]] std::span<const T> replica(size_t i) const noexcept
+	{
+		return {replicas_[i], size_};
+	}
+
+	/** @brief 副本份数 */
+	[[nodiscard]] size_t replica_count() const noexcept
+	{
+		return replicas_.size();
+	}
+
+	[[nodiscard]] size_t size() const noexcept
+	{
+		return size_;
+	}
+
+private:
+	std::vector<T*> replicas_;
+	std::vector<size_t> node_index_;
+	size_t size_;
+
+	[[nodiscard]] size_t bytes() const noexcept
+	{
+		return size_ * sizeof(T);
+	}
+
+	void release() noexcept
+	{
+		for(T* p : replicas_)
+		{
+			if(!p) continue;
+			std::destroy(p, p + size_);
+			numa_details::unmap_pages(p, bytes());
+		}
+		replicas_.clear();
+	}
+};
+
+} // namespace hyx
@@ -0,0 +1,240 @@
+#pragma once
+
+#include <version>
+#if __cplusplus < 202302L
+#error "hyx_prefix.hpp requires C++23 or later."
+#endif
+
+/**
+ * @file hyx_prefix.hpp
+ * @brief 构建期预计算 autoseq 前缀
+ * @note 生成器程序把登记的数列前缀写成头文件 (静态数组) 或二进制块 (供 #embed)，
+ *       运行时通过 hyx::adopt_prefix 直接采用，数据位于可执行文件的只读段，多进程共享同一物理页
+ *
+ * @version 1.0.0
+ * @author Heylyx841
+ * @date 2026-10-18
+ * @license MIT License
+ */
+
+#include "hyx_autoseq.hpp"
+
+#include <string>       // std::string
+#include <string_view>  // std::string_view
+#include <vector>       // std::vector
+#include <span>         // std::span
+#include <functional>   // std::function
+#include <filesystem>   // std::filesystem::path
+#include <fstream>      // std::ofstream
+#include <ostream>      // std::ostream
+#include <iostream>     // std::cerr
+#include <ios>          // std::hexfloat
+#include <limits>       // std::numeric_limits
+#include <cstdint>      // std::int64_t, std::uint64_t, std::uintptr_t
+#include <cstddef>      // size_t
+#include <type_traits>  // std::is_integral_v, std::is_floating_point_v
+#include <stdexcept>    // std::invalid_argument, std::runtime_error
+#include <memory>       // std::start_lifetime_as_array
+
+/**
+ * @namespace hyx
+ */
+namespace hyx
+{
+
+/**
+ * @namespace prefix_details
+ * @brief 内部实现细节
+ */
+namespace prefix_details
+{
+
+/** @brief 可以写成 C++ 字面量的元素类型 */
+template <typename T>
+concept literal_element = (std::is_integral_v<T> && !std::is_same_v<T, bool>) ||
+                          std::is_same_v<T, float> || std::is_same_v<T, double>;
+
+/** @brief 生成代码中使用的类型名 */
+template <literal_element T>
+[[nodiscard]] constexpr std::string_view type_name() noexcept
+{
+	if constexpr(std::is_same_v<T, float>) return "float";
+	else if constexpr(std::is_same_v<T, double>) return "double";
+	else if constexpr(std::is_signed_v<T>)
+	{
+		if constexpr(sizeof(T) == 1) return "std::int8_t";
+		else if constexpr(sizeof(T) == 2) return "std::int16_t";
+		else if constexpr(sizeof(T) == 4) return "std::int32_t";
+		else return "std::int64_t";
+	}
+	else
+	{
+		if constexpr(sizeof(T) == 1) return "std::uint8_t";
+		else if constexpr(sizeof(T) == 2) return "std::uint16_t";
+		else if constexpr(sizeof(T) == 4) return "std::uint32_t";
+		else return "std::uint64_t";
+	}
+}
+
+template <literal_element T>
+void write_literal(std::ostream& os, T v)
+{
+	if constexpr(std::is_floating_point_v<T>)
+	{
+		// 十六进制浮点字面量可以无损往返
+		os << std::hexfloat << v << std::defaultfloat;
+		if constexpr(std::is_same_v<T, float>) os << 'f';
+	}
+	else if constexpr(std::is_signed_v<T>)
+	{
+		// 最小值无法写成 "-字面量"
+		if(v == std::numeric_limits<T>::min())
+			os << '(' << static_cast<std::int64_t>(v) + 1 << " - 1)";
+		else
+			os << static_cast<std::int64_t>(v);
+	}
+	else
+	{
+		os << static_cast<std::uint64_t>(v) << 'u';
+	}
+}
+
+} // namespace prefix_details
+
+/**
+ * @brief 将前缀写成可 #include 的头文件
+ * @param name 生成的 inline constexpr 数组名，另写出项数常量 <name>_size
+ * @note 不允许零长度数组，空前缀的数组中只有一个占位元素；采用前缀时应以
+ *       std::span(name, name_size) 为准，而不是数组本身的长度
+ */
+template <prefix_details::literal_element T>
+void write_prefix_source(std::ostream& os, std::string_view name, std::span<const T> prefix)
+{
+	os << "// Generated by hyx::write_prefix_source. Do not edit.\n"
+	   << "#pragma once\n\n"
+	   << "#include <cstddef>\n"
+	   << "#include <cstdint>\n\n"
+	   << "inline constexpr std::size_t " << name << "_size = " << prefix.size() << ";\n\n"
+	   << "inline constexpr " << prefix_details::type_name<T>() << ' ' << name << "[] = {";
+	for(size_t i = 0; i < prefix.size(); ++i)
+	{
+		os << (i % 8 == 0 ? "\n\t" : " ");
+		prefix_details::write_literal(os, prefix[i]);
+		os << ',';
+	}
+	if(prefix.empty()) os << "\n\t" << prefix_details::type_name<T>() << "{}"; // 占位，不计入 <name>_size
+	os << "\n};\n";
+}
+
+/**
+ * @brief 将前缀按本机字节序写成原始二进制块，供 #embed 引入
+ */
+template <typename T>
+requires std::is_trivially_copyable_v<T>
+void write_prefix_blob(std::ostream& os, std::span<const T> prefix)
+{
+	os.write(reinterpret_cast<const char*>(prefix.data()), static_cast<std::streamsize>(prefix.size_bytes()));
+}
+
+/**
+ * @brief 将 #embed 引入的字节块解释为前缀
+ * @note 字节块须按 alignas(T) 声明，例如
+ *       alignas(std::uint64_t) static constexpr unsigned char fib_blob[] = {
+ *       #embed "fib.bin"
+ *       };
+ */
+template <typename T>
+requires std::is_trivially_copyable_v<T>
+[[nodiscard]] std::span<const T> prefix_from_bytes(std::span<const unsigned char> bytes)
+{
+	if(bytes.size() % sizeof(T) != 0) [[unlikely]]
+		throw std::invalid_argument("hyx::prefix_from_bytes: Blob size is not a multiple of sizeof(T).");
+	if(reinterpret_cast<std::uintptr_t>(bytes.data()) % alignof(T) != 0) [[unlikely]]
+		throw std::invalid_argument("hyx::prefix_from_bytes: Blob is not aligned for T.");
+
+	const size_t n = bytes.size() / sizeof(T);
+#if defined(__cpp_lib_start_lifetime_as)
+	return {std::start_lifetime_as_array<T>(bytes.data(), n), n};
+#else
+	return {reinterpret_cast<const T*>(bytes.data()), n};
+#endif
+}
+
+/**
+ * @class prefix_generator
+ * @brief 构建期前缀生成器
+ * @note 在一个独立的小程序中登记数列后调用 run()，由构建系统在编译主程序前执行：
+ *
+ *       int main(int argc, char** argv)
+ *       {
+ *           hyx::autoseq<std::uint64_t> fib(...);
+ *           return hyx::prefix_generator{}.add("fib_prefix", fib, 90).run(argc, argv);
+ *       }
+ *
+ *       run() 向 argv[1] 目录写出 <name>.hpp，平凡可复制类型另写出 <name>.bin
+ */
+class prefix_generator
+{
+public:
+	/**
+	 * @brief 登记一个数列的前 count 项
+	 * @note 只保存引用，seq 必须存活到 run() 结束
+	 */
+	template <prefix_details::literal_element T, typename Alloc, size_t N>
+	prefix_generator& add(std::string name, const autoseq<T, Alloc, N>& seq, size_t count)
+	{
+		jobs_.push_back({std::move(name), [&seq, count](const std::filesystem::path& dir, const std::string& stem)
+		{
+			const std::span<const T> prefix = seq.slice(0, count);
+			write_file(dir / (stem + ".hpp"), std::ios::out, [&](std::ostream& os) { write_prefix_source(os, stem, prefix); });
+			write_file(dir / (stem + ".bin"), std::ios::out | std::ios::binary, [&](std::ostream& os) { write_prefix_blob(os, prefix); });
+		}});
+		return *this;
+	}
+
+	/**
+	 * @brief 生成全部已登记的前缀
+	 * @return 进程退出码
+	 */
+	int run(int argc, char** argv) const
+	{
+		if(argc < 2)
+		{
+			std::cerr << "usage: " << (argc > 0 ? argv[0] : "prefix_generator") << " <output-dir>\n";
+			return 2;
+		}
+		try
+		{
+			const std::filesystem::path dir = argv[1];
+			std::filesystem::create_directories(dir);
+			for(const auto& job : jobs_)
+				job.write(dir, job.name);
+		}
+		catch(const std::exception& e)
+		{
+			std::cerr << "hyx::prefix_generator: " << e.what() << '\n';
+			return 1;
+		}
+		return 0;
+	}
+
+private:
+	struct Job
+	{
+		std::string name;
+		std::function<void(const std::filesystem::path&, const std::string&)> write;
+	};
+
+	std::vector<Job> jobs_;
+
+	template <typename Writer>
+	static void write_file(const std::filesystem::path& path, std::ios::openmode mode, Writer&& writer)
+	{
+		std::ofstream os(path, mode | std::ios::trunc);
+		if(!os) throw std::runtime_error("cannot open " + path.string());
+		writer(os);
+		if(!os) throw std::runtime_error("failed to write " + path.string());
+	}
+};
+
+} // namespace hyx
@@ -0,0 +1,412 @@
+#pragma once
+
+#include <version>
+#if __cplusplus < 202302L
+#error "hyx_pushseq.hpp requires C++23 or later."
+#endif
+
+/**
+ * @file hyx_pushseq.hpp
+ * @brief 推送式数列：外部逐项追加的源数列，以及在其上增量维护的派生数列
+ * @note 源数列由调用方 push 新项；派生数列 (滑动和、滤波、以输入驱动的递推等) 内部是一个 autoseq，
+ *       输入的水位 (已就绪的项数) 前进时只计算新增的项，已算出的项保持不变。
+ *       每个节点的水位前进时同步通知订阅者。只允许单线程调用，跨线程推送需要外部同步
+ *
+ * @version 1.0.0
+ * @author Heylyx841
+ * @date 2026-10-18
+ * @license MIT License
+ */
+
+#include "hyx_autoseq.hpp"
+
+#include <vector>       // std::vector
+#include <map>          // std::multimap
+#include <memory>       // std::allocator
+#include <functional>   // std::move_only_function
+#include <initializer_list> // std::initializer_list
+#include <ranges>       // std::ranges::input_range
+#include <span>         // std::span
+#include <limits>       // std::numeric_limits
+#include <algorithm>    // std::min, std::max, std::erase, std::erase_if
+#include <cstddef>      // size_t, std::ptrdiff_t
+#include <cassert>      // assert
+#include <utility>      // std::forward, std::move, std::exchange
+#include <stdexcept>    // std::out_of_range, std::invalid_argument
+
+/**
+ * @namespace hyx
+ */
+namespace hyx
+{
+
+class push_node;
+
+/**
+ * @struct push_link
+ * @brief 派生数列的一条输入：第 n 项最多读取输入的第 n + lead 项
+ * @note lead = 0 为因果读取 (x[0..n])，lead > 0 允许向前看 (如中心滑动平均)，lead < 0 表示只读到滞后的项
+ */
+struct push_link
+{
+	const push_node* node;
+	std::ptrdiff_t lead = 0;
+
+	push_link(const push_node& input, std::ptrdiff_t lead_terms = 0) noexcept
+		: node(&input), lead(lead_terms)
+	{
+	}
+};
+
+/**
+ * @class push_node
+ * @brief 推送网络中的节点：维护水位并向订阅者与下游派生数列传播
+ * @note 节点之间以指针相连，因此不可复制也不可移动；输入必须比依赖它的派生数列活得更久
+ */
+class push_node
+{
+public:
+	using watermark_callback = std::move_only_function<void(size_t)>;
+
+	push_node(const push_node&) = delete;
+	push_node& operator=(const push_node&) = delete;
+
+	virtual ~push_node()
+	{
+		assert(dependents_.empty() && "hyx::push_node: Destroyed before its derived sequences.");
+		for(const auto& in : inputs_)
+			std::erase(in.node->dependents_, this);
+	}
+
+	/** @brief 水位：[0, ready()) 中的项已就绪 */
+	[[nodiscard]] size_t ready() const noexcept
+	{
+		return ready_;
+	}
+
+	/**
+	 * @brief 订阅水位变化，每次水位前进时以新的水位调用 f
+	 * @return 用于 unsubscribe 的编号
+	 * @note 回调中可以订阅或退订 (包括退订自身)；本轮通知中新加入的订阅从下一次水位前进开始生效
+	 */
+	size_t subscribe(watermark_callback f)
+	{
+		subscribers_.push_back({next_id_, std::move(f)});
+		return next_id_++;
+	}
+
+	void unsubscribe(size_t id)
+	{
+		for(auto& s : subscribers_)
+		{
+			if(s.id != id) continue;
+			// 正在运行的回调已移到 notify 的局部变量中，由它在返回后丢弃
+			s.active = false;
+			s.callback = nullptr;
+		}
+		if(notifying_ == 0)
+			std::erase_if(subscribers_, [](const Subscriber& s) { return !s.active; });
+	}
+
+	/**
+	 * @brief 第 n 项就绪时调用一次 f(ready())；已经就绪时立即调用
+	 */
+	void when_ready(size_t n, watermark_callback f)
+	{
+		if(n < ready_)
+			f(ready_);
+		else
+			waiting_.emplace(n, std::move(f));
+	}
+
+protected:
+	push_node() noexcept = default;
+
+	/**
+	 * @brief 登记一条输入
+	 * @throws std::invalid_argument 输入为自身
+	 */
+	void link(const push_link& in)
+	{
+		if(in.node == this) [[unlikely]]
+			throw std::invalid_argument("hyx::push_node: A node cannot depend on itself.");
+		in.node->dependents_.push_back(this);
+		inputs_.push_back(in);
+	}
+
+	/**
+	 * @brief 输入水位决定的可计算项数：对所有输入 n + lead < ready 的最大前缀
+	 */
+	[[nodiscard]] size_t computable() const noexcept
+	{
+		size_t limit = std::numeric_limits<size_t>::max();
+		for(const auto& in : inputs_)
+		{
+			const size_t r = in.node->ready_;
+			size_t count;
+			if(in.lead >= 0)
+				count = r > static_cast<size_t>(in.lead) ? r - static_cast<size_t>(in.lead) : 0;
+			else
+				count = r + static_cast<size_t>(-in.lead);
+			limit = std::min(limit, count);
+		}
+		return limit;
+	}
+
+	/** @brief 输入水位前进后由上游调用 */
+	virtual void catch_up() {}
+
+	/**
+	 * @brief 推进水位：先通知本节点的订阅者，再让下游派生数列跟进
+	 */
+	void advance(size_t ready)
+	{
+		if(ready <= ready_) return;
+		ready_ = ready;
+		notify();
+		// 下游在 catch_up 中可能再订阅本节点之外的节点，但不会增删本节点的下游
+		for(size_t i = 0; i < dependents_.size(); ++i)
+			dependents_[i]->catch_up();
+	}
+
+private:
+	struct Subscriber
+	{
+		size_t id;
+		watermark_callback callback;
+		bool active = true;
+	};
+
+	size_t ready_ = 0;
+	std::vector<push_link> inputs_;
+	mutable std::vector<push_node*> dependents_;
+	std::vector<Subscriber> subscribers_;
+	std::multimap<size_t, watermark_callback> waiting_;
+	size_t next_id_ = 0;
+	size_t notifying_ = 0;
+
+	void notify()
+	{
+		const size_t ready = ready_;
+		++notifying_;
+		try
+		{
+			// 回调期间订阅可能使 subscribers_ 重新分配，因此先把回调移出再调用，返回后按下标放回；
+			// 通知期间不删除元素，下标保持有效。移出期间槽位为空，嵌套的通知会跳过它
+			const size_t count = subscribers_.size();
+			for(size_t i = 0; i < count; ++i)
+			{
+				if(!subscribers_[i].active || !subscribers_[i].callback) continue;
+				auto f = std::exchange(subscribers_[i].callback, nullptr);
+				try
+				{
+					f(ready);
+				}
+				catch(...)
+				{
+					if(subscribers_[i].active) subscribers_[i].callback = std::move(f);
+					throw;
+				}
+				if(subscribers_[i].active) subscribers_[i].callback = std::move(f);
+			}
+			while(!waiting_.empty() && waiting_.begin()->first < ready)
+			{
+				auto f = std::move(waiting_.extract(waiting_.begin()).mapped());
+				f(ready);
+			}
+		}
+		catch(...)
+		{
+			--notifying_;
+			throw;
+		}
+		if(--notifying_ == 0)
+			std::erase_if(subscribers_, [](const Subscriber& s) { return !s.active; });
+	}
+};
+
+/**
+ * @class push_source
+ * @brief 由调用方逐项追加的源数列
+ * @note 追加后立即推进水位并同步更新下游；operator[] / view 返回的引用在下一次追加后可能失效
+ */
+template <typename T, typename Alloc = std::allocator<T>>
+class push_source : public push_node
+{
+public:
+	push_source() = default;
+
+	explicit push_source(const Alloc& alloc)
+		: terms_(alloc)
+	{
+	}
+
+	void push(const T& value)
+	{
+		terms_.push_back(value);
+		advance(terms_.size());
+	}
+
+	void push(T&& value)
+	{
+		terms_.push_back(std::move(value));
+		advance(terms_.size());
+	}
+
+	template <typename... Args>
+	void emplace(Args&&... args)
+	{
+		terms_.emplace_back(std::forward<Args>(args)...);
+		advance(terms_.size());
+	}
+
+	/**
+	 * @brief 一次追加多项，水位只推进一次，下游按整批增量计算
+	 */
+	template <std::ranges::input_range R>
+	requires std::convertible_to<std::ranges::range_reference_t<R>, T>
+	void append(R&& values)
+	{
+		for(auto&& v : values)
+			terms_.emplace_back(std::forward<decltype(v)>(v));
+		advance(terms_.size());
+	}
+
+	[[nodiscard]] const T& operator[](size_t n) const noexcept
+	{
+		assert(n < terms_.size() && "hyx::push_source: Term has not arrived yet.");
+		return terms_[n];
+	}
+
+	[[nodiscard]] const T& at(size_t n) const
+	{
+		if(n >= terms_.size()) [[unlikely]]
+			throw std::out_of_range("hyx::push_source: Term has not arrived yet.");
+		return terms_[n];
+	}
+
+	[[nodiscard]] std::span<const T> view() const noexcept
+	{
+		return terms_;
+	}
+
+	[[nodiscard]] size_t size() const noexcept
+	{
+		return terms_.size();
+	}
+
+	void reserve(size_t n)
+	{
+		terms_.reserve(n);
+	}
+
+	[[nodiscard]] Alloc get_allocator() const noexcept
+	{
+		return terms_.get_allocator();
+	}
+
+private:
+	std::vector<T, Alloc> terms_;
+};
+
+/**
+ * @class push_derived
+ * @brief 定义在其它推送节点之上的派生数列
+ * @note 公式与 autoseq 相同 (按值、MathContext、就地、多项输出均可)，通过捕获读取输入；
+ *       第 n 项只能读取各输入 push_link 声明范围内的项。输入水位前进时只计算新增的项，
+ *       多项输出公式应在请求满足后停止，不要越过输入水位产出
+ */
+template <typename T, typename Alloc = std::allocator<T>>
+class push_derived : public push_node
+{
+public:
+	/**
+	 * @param inputs 读取的输入节点，至少一个
+	 * @param g 生成公式
+	 * @param init_values 不依赖输入的初始项 (如递推的初值)
+	 * @throws std::invalid_argument 没有输入
+	 */
+	template <typename Gen, typename... InitArgs>
+	requires(std::convertible_to<InitArgs, T> && ...)
+	push_derived(std::initializer_list<push_link> inputs, Gen&& g, InitArgs&&... init_values)
+		: push_derived(std::allocator_arg, Alloc(), inputs, std::forward<Gen>(g), std::forward<InitArgs>(init_values)...)
+	{
+	}
+
+	template <typename Gen, typename... InitArgs>
+	requires(std::convertible_to<InitArgs, T> && ...)
+	push_derived(std::allocator_arg_t, const Alloc& alloc, std::initializer_list<push_link> inputs, Gen&& g, InitArgs&&... init_values)
+		: seq_(std::allocator_arg, alloc, std::forward<Gen>(g), std::forward<InitArgs>(init_values)...)
+		, initial_(sizeof...(init_values))
+	{
+		if(inputs.size() == 0) [[unlikely]]
+			throw std::invalid_argument("hyx::push_derived: At least one input is required.");
+		// 构造中途抛出时，基类析构会把已登记的连接一并断开
+		for(const auto& in : inputs)
+			link(in);
+		advance(initial_);
+		catch_up();
+	}
+
+	[[nodiscard]] const T& operator[](size_t n) const noexcept
+	{
+		assert(n < ready() && "hyx::push_derived: Term is not ready yet.");
+		return seq_.view()[n];
+	}
+
+	[[nodiscard]] const T& at(size_t n) const
+	{
+		if(n >= ready()) [[unlikely]]
+			throw std::out_of_range("hyx::push_derived: Term is not ready yet.");
+		return seq_.view()[n];
+	}
+
+	/** @brief 已就绪的项 */
+	[[nodiscard]] std::span<const T> view() const noexcept
+	{
+		return seq_.view().first(std::min(ready(), seq_.size()));
+	}
+
+	[[nodiscard]] size_t size() const noexcept
+	{
+		return ready();
+	}
+
+	/** @brief 预分配缓存容量 */
+	void reserve(size_t n) const
+	{
+		seq_.reserve(n);
+	}
+
+	[[nodiscard]] Alloc get_allocator() const noexcept
+	{
+		return seq_.get_allocator();
+	}
+
+protected:
+	/**
+	 * @brief 计算到输入允许的位置
+	 * @note 公式抛出异常时，已算出的项仍然发布，再把异常交给触发本次更新的调用方
+	 */
+	void catch_up() override
+	{
+		const size_t target = std::max(initial_, computable());
+		if(target <= ready()) return;
+		try
+		{
+			seq_.prefetch_up_to(target - 1);
+		}
+		catch(...)
+		{
+			advance(std::min(seq_.size(), target));
+			throw;
+		}
+		advance(target);
+	}
+
+private:
+	autoseq<T, Alloc> seq_;
+	size_t initial_;
+};
+
+} // namespace hyx
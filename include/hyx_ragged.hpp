@@ -0,0 +1,460 @@
+#pragma once
+
+#include <version>
+#if __cplusplus < 202302L
+#error "hyx_ragged.hpp requires C++23 or later."
+#endif
+
+/**
+ * @file hyx_ragged.hpp
+ * @brief 项为变长序列的数列 (多项式系数、划分、数字串等) 的紧凑存储
+ * @note 所有项的元素顺序存放在同一个元素池中，另以偏移数组记录每项的边界；
+ *       访问第 n 项得到 std::span<const U>。公式通过 builder 追加元素，builder 是跨项复用的暂存区，
+ *       公式返回后整体移入元素池，因此公式执行期间历史项的 span 始终有效
+ *
+ * @version 1.0.0
+ * @author Heylyx841
+ * @date 2026-10-18
+ * @license MIT License
+ */
+
+#include <vector>       // std::vector
+#include <span>         // std::span
+#include <ranges>       // std::ranges::input_range, std::ranges::begin, std::ranges::end
+#include <memory>       // std::allocator, std::allocator_traits
+#include <functional>   // std::move_only_function, std::invoke
+#include <iterator>     // std::make_move_iterator
+#include <utility>      // std::forward, std::move
+#include <concepts>     // std::convertible_to
+#include <type_traits>  // std::is_invocable_v
+#include <cstddef>      // size_t, std::ptrdiff_t
+#include <cassert>      // assert
+#include <stdexcept>    // std::out_of_range, std::invalid_argument
+
+/**
+ * @namespace hyx
+ */
+namespace hyx
+{
+
+/**
+ * @class ragged_view
+ * @brief 连续若干项的只读视图
+ * @note 第 i 项为 flat()[offsets[i] - offsets[0], offsets[i + 1] - offsets[0])
+ */
+template <typename U>
+class ragged_view
+{
+public:
+	ragged_view() noexcept = default;
+
+	ragged_view(const U* base, const size_t* offsets, size_t count) noexcept
+		: base_(base), offsets_(offsets), count_(count)
+	{
+	}
+
+	/** @brief 第 i 项 */
+	[[nodiscard]] std::span<const U> operator[](size_t i) const noexcept
+	{
+		assert(i < count_ && "hyx::ragged_view: Index out of range.");
+		return {base_ + offsets_[i], offsets_[i + 1] - offsets_[i]};
+	}
+
+	/** @brief 项数 */
+	[[nodiscard]] size_t size() const noexcept
+	{
+		return count_;
+	}
+
+	[[nodiscard]] bool empty() const noexcept
+	{
+		return count_ == 0;
+	}
+
+	[[nodiscard]] std::span<const U> front() const noexcept
+	{
+		return (*this)[0];
+	}
+
+	[[nodiscard]] std::span<const U> back() const noexcept
+	{
+		return (*this)[count_ - 1];
+	}
+
+	/** @brief 所有项的元素，按项顺序首尾相接 */
+	[[nodiscard]] std::span<const U> flat() const noexcept
+	{
+		if(count_ == 0) return {};
+		return {base_ + offsets_[0], offsets_[count_] - offsets_[0]};
+	}
+
+	/** @brief [first, first + count) 项的子视图 */
+	[[nodiscard]] ragged_view subview(size_t first, size_t count) const noexcept
+	{
+		assert(first + count <= count_ && "hyx::ragged_view: Subview out of range.");
+		return {base_, offsets_ + first, count};
+	}
+
+private:
+	const U* base_ = nullptr;
+	/** @brief count_ + 1 个边界，指向元素池起点的绝对偏移 */
+	const size_t* offsets_ = nullptr;
+	size_t count_ = 0;
+};
+
+/**
+ * @namespace ragged_details
+ * @brief 内部实现细节
+ */
+namespace ragged_details
+{
+
+/**
+ * @class RaggedBuilder
+ * @brief 构造新项的暂存区，容量跨项复用
+ */
+template <typename U, typename Alloc>
+class RaggedBuilder
+{
+public:
+	explicit RaggedBuilder(std::vector<U, Alloc>& buf) noexcept
+		: buf_(buf)
+	{
+	}
+
+	void push_back(const U& value)
+	{
+		buf_.push_back(value);
+	}
+
+	void push_back(U&& value)
+	{
+		buf_.push_back(std::move(value));
+	}
+
+	template <typename... Args>
+	U& emplace_back(Args&&... args)
+	{
+		return buf_.emplace_back(std::forward<Args>(args)...);
+	}
+
+	/** @brief 追加一个范围内的全部元素 */
+	template <std::ranges::input_range R>
+	requires std::convertible_to<std::ranges::range_reference_t<R>, U>
+	void append(R&& range)
+	{
+		for(auto&& v : range)
+			buf_.emplace_back(std::forward<decltype(v)>(v));
+	}
+
+	void resize(size_t n)
+	{
+		buf_.resize(n);
+	}
+
+	void resize(size_t n, const U& value)
+	{
+		buf_.resize(n, value);
+	}
+
+	void reserve(size_t n)
+	{
+		buf_.reserve(n);
+	}
+
+	void clear() noexcept
+	{
+		buf_.clear();
+	}
+
+	/** @brief 已写入的元素，可原地修改 (如卷积累加) */
+	[[nodiscard]] U& operator[](size_t i) noexcept
+	{
+		return buf_[i];
+	}
+
+	[[nodiscard]] const U& operator[](size_t i) const noexcept
+	{
+		return buf_[i];
+	}
+
+	[[nodiscard]] std::span<U> elements() noexcept
+	{
+		return buf_;
+	}
+
+	[[nodiscard]] size_t size() const noexcept
+	{
+		return buf_.size();
+	}
+
+	[[nodiscard]] bool empty() const noexcept
+	{
+		return buf_.empty();
+	}
+
+private:
+	std::vector<U, Alloc>& buf_;
+};
+
+/**
+ * @struct RaggedContext
+ * @brief 数学公式执行上下文，F[i] 为第 i 项的 span
+ */
+template <typename U>
+struct RaggedContext
+{
+	/** @brief 当前正在计算的项索引 n */
+	size_t index_val;
+	/** @brief 已计算的第 [0, n) 项 */
+	ragged_view<U> history;
+
+	[[nodiscard]] size_t n() const noexcept
+	{
+		return index_val;
+	}
+
+	[[nodiscard]] std::span<const U> last() const noexcept
+	{
+		assert(!history.empty() && "hyx::ragged_autoseq: Cannot access last() on empty sequence.");
+		return history.back();
+	}
+
+	[[nodiscard]] std::span<const U> operator[](size_t i) const noexcept
+	{
+		return history[i];
+	}
+};
+
+template <typename U, typename Alloc>
+using RaggedFormula = std::move_only_function<void(size_t, ragged_view<U>, RaggedBuilder<U, Alloc>&)>;
+
+/**
+ * @brief 智能签名适配
+ */
+template <typename U, typename Alloc, typename F>
+RaggedFormula<U, Alloc> make_ragged_dispatch(F&& f)
+{
+	using Builder = RaggedBuilder<U, Alloc>;
+	using Context = RaggedContext<U>;
+
+	// 模式 A: 原始模式 void(size_t n, ragged_view history, builder&)
+	if constexpr(std::is_invocable_v<F, size_t, ragged_view<U>, Builder&>)
+	{
+		return [f = std::forward<F>(f)](size_t n, ragged_view<U> h, Builder& out) mutable
+		{
+			std::invoke(f, n, h, out);
+		};
+	}
+	// 模式 B: 数学上下文模式 void(context, builder&)
+	else if constexpr(std::is_invocable_v<F, Context, Builder&>)
+	{
+		return [f = std::forward<F>(f)](size_t n, ragged_view<U> h, Builder& out) mutable
+		{
+			std::invoke(f, Context {n, h}, out);
+		};
+	}
+	else
+	{
+		static_assert(false, "hyx::ragged_autoseq: Unrecognized formula signature. Expected "
+		                     "void(size_t, ragged_view, builder&) or void(context, builder&).");
+	}
+}
+
+} // namespace ragged_details
+
+/**
+ * @class ragged_autoseq
+ * @brief 项为变长序列的惰性数列
+ * @note operator[] 返回的 span 与 view() 在之后扩展数列时可能失效 (元素池扩容)，与 std::vector 的迭代器相同；
+ *       公式执行期间传入的历史视图不会失效
+ *
+ * @tparam U 元素类型
+ * @tparam Alloc 元素池的分配器
+ */
+template <typename U, typename Alloc = std::allocator<U>>
+class ragged_autoseq
+{
+public:
+	using element_type = U;
+	using allocator_type = Alloc;
+	using builder = ragged_details::RaggedBuilder<U, Alloc>;
+	using context = ragged_details::RaggedContext<U>;
+
+private:
+	using OffsetAlloc = typename std::allocator_traits<Alloc>::template rebind_alloc<size_t>;
+
+	/** @brief 所有项的元素 */
+	mutable std::vector<U, Alloc> pool_;
+	/** @brief size() + 1 个边界，offsets_[0] == 0 */
+	mutable std::vector<size_t, OffsetAlloc> offsets_;
+	/** @brief builder 的暂存区，容量跨项复用 */
+	mutable std::vector<U, Alloc> scratch_;
+	mutable ragged_details::RaggedFormula<U, Alloc> formula_;
+
+	void ensure_calculated(size_t target_index) const
+	{
+		if(target_index < size()) [[likely]]
+			return;
+
+		builder out(scratch_);
+		while(size() <= target_index)
+		{
+			const size_t n = size();
+			scratch_.clear();
+			try
+			{
+				formula_(n, view(), out);
+			}
+			catch(...)
+			{
+				scratch_.clear();
+				throw;
+			}
+			commit();
+		}
+	}
+
+	/** @brief 把暂存区整体移入元素池，追加一个边界 */
+	void commit() const
+	{
+		// 先追加边界：两者都按几何倍数增长，任一步抛出时撤销另一步，缓存保持原状
+		const size_t old = pool_.size();
+		offsets_.push_back(old + scratch_.size());
+		try
+		{
+			pool_.insert(pool_.end(), std::make_move_iterator(scratch_.begin()), std::make_move_iterator(scratch_.end()));
+		}
+		catch(...)
+		{
+			offsets_.pop_back();
+			pool_.erase(pool_.begin() + static_cast<std::ptrdiff_t>(old), pool_.end());
+			throw;
+		}
+		scratch_.clear();
+	}
+
+public:
+	/**
+	 * @brief 构造函数
+	 * @param init 初始项，每个都是元素可转换为 U 的范围
+	 */
+	template <typename Gen, std::ranges::input_range... Init>
+	requires(std::convertible_to<std::ranges::range_reference_t<Init>, U> && ...)
+	explicit ragged_autoseq(Gen&& g, Init&&... init)
+		: ragged_autoseq(std::allocator_arg, Alloc(), std::forward<Gen>(g), std::forward<Init>(init)...)
+	{
+	}
+
+	/**
+	 * @brief 使用指定分配器的构造函数
+	 */
+	template <typename Gen, std::ranges::input_range... Init>
+	requires(std::convertible_to<std::ranges::range_reference_t<Init>, U> && ...)
+	ragged_autoseq(std::allocator_arg_t, const Alloc& alloc, Gen&& g, Init&&... init)
+		: pool_(alloc)
+		, offsets_(1, 0, OffsetAlloc(alloc))
+		, scratch_(alloc)
+		, formula_(ragged_details::make_ragged_dispatch<U, Alloc>(std::forward<Gen>(g)))
+	{
+		if constexpr(sizeof...(init) > 0)
+		{
+			offsets_.reserve(sizeof...(init) + 1);
+			builder out(scratch_);
+			((out.append(std::forward<Init>(init)), commit()), ...);
+		}
+	}
+
+	ragged_autoseq(const ragged_autoseq&) = delete;
+	ragged_autoseq& operator=(const ragged_autoseq&) = delete;
+
+	ragged_autoseq(ragged_autoseq&&) noexcept = default;
+	ragged_autoseq& operator=(ragged_autoseq&&) noexcept = default;
+
+	/**
+	 * @brief 访问第 n 项
+	 */
+	[[nodiscard]] std::span<const U> operator[](size_t n) const
+	{
+		ensure_calculated(n);
+		return {pool_.data() + offsets_[n], offsets_[n + 1] - offsets_[n]};
+	}
+
+	/**
+	 * @brief 带边界检查访问第 n 项
+	 */
+	[[nodiscard]] std::span<const U> at(size_t n) const
+	{
+		if(n >= offsets_.max_size() - 1) [[unlikely]]
+			throw std::out_of_range("hyx::ragged_autoseq: Index exceeds maximum container size.");
+		return (*this)[n];
+	}
+
+	/**
+	 * @brief 缓存数列到第 n 项
+	 */
+	void prefetch_up_to(size_t n) const
+	{
+		ensure_calculated(n);
+	}
+
+	/**
+	 * @brief 丢弃第 n 项及之后的缓存，之后访问时重新计算
+	 */
+	void trim(size_t n) const
+	{
+		if(n >= size()) return;
+		pool_.erase(pool_.begin() + static_cast<std::ptrdiff_t>(offsets_[n]), pool_.end());
+		offsets_.resize(n + 1);
+	}
+
+	/**
+	 * @brief 预分配项数与元素总数的容量
+	 */
+	void reserve(size_t terms, size_t elements) const
+	{
+		offsets_.reserve(terms + 1);
+		pool_.reserve(elements);
+	}
+
+	/**
+	 * @brief 多下标切片访问 [start, end)
+	 */
+	[[nodiscard]] ragged_view<U> slice(size_t start, size_t end) const
+	{
+		if(start > end) [[unlikely]]
+			throw std::invalid_argument("hyx::ragged_autoseq: Invalid slice range (start > end).");
+		if(start == end) return {};
+		ensure_calculated(end - 1);
+		return view().subview(start, end - start);
+	}
+
+	/**
+	 * @brief 获取当前已缓存数据的只读视图
+	 */
+	[[nodiscard]] ragged_view<U> view() const noexcept
+	{
+		return {pool_.data(), offsets_.data(), size()};
+	}
+
+	/** @brief 获取当前已缓存的项数 */
+	[[nodiscard]] size_t size() const noexcept
+	{
+		// 被移动后 offsets_ 为空
+		return offsets_.empty() ? 0 : offsets_.size() - 1;
+	}
+
+	/** @brief 已缓存各项的元素总数 */
+	[[nodiscard]] size_t elements() const noexcept
+	{
+		return pool_.size();
+	}
+
+	/** @brief 获取元素池使用的分配器 */
+	[[nodiscard]] Alloc get_allocator() const noexcept
+	{
+		return pool_.get_allocator();
+	}
+};
+
+} // namespace hyx
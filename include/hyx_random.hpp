@@ -0,0 +1,440 @@
+#pragma once
+
+#include <version>
+#if __cplusplus < 202302L
+#error "hyx_random.hpp requires C++23 or later."
+#endif
+
+/**
+ * @file hyx_random.hpp
+ * @brief 基于计数器的可复现随机数列 (Philox4x32-10)
+ * @note 第 n 项只取决于 (seed, stream, n)：随机访问为 O(1) 且无需缓存，任意区间可由多个线程分别填充。
+ *       批量填充一次处理 16 / 8 个计数器块 (AVX-512 / AVX2，按编译目标选择)，否则使用标量实现。
+ *       均匀分布与 Ziggurat 正态分布同样是 n 的纯函数，按块生成
+ *
+ * @version 1.0.0
+ * @author Heylyx841
+ * @date 2026-10-18
+ * @license MIT License
+ */
+
+#include "hyx_autoseq.hpp"
+
+#include <cstdint>      // std::uint32_t, std::uint64_t
+#include <cstddef>      // size_t
+#include <cmath>        // std::exp, std::log, std::sqrt
+#include <span>         // std::span
+#include <array>        // std::array
+#include <algorithm>    // std::min
+
+#if defined(__AVX512F__)
+#define HYX_RANDOM_AVX512 1
+#endif
+#if defined(__AVX2__)
+#define HYX_RANDOM_AVX2 1
+#endif
+#if defined(HYX_RANDOM_AVX512) || defined(HYX_RANDOM_AVX2)
+#include <immintrin.h>  // _mm256_mul_epu32, _mm512_mul_epu32 ...
+#endif
+
+/**
+ * @namespace hyx
+ */
+namespace hyx
+{
+
+/**
+ * @namespace random_details
+ * @brief 内部实现细节
+ */
+namespace random_details
+{
+
+inline constexpr std::uint32_t philox_m0 = 0xD2511F53u;
+inline constexpr std::uint32_t philox_m1 = 0xCD9E8D57u;
+inline constexpr std::uint32_t philox_w0 = 0x9E3779B9u;
+inline constexpr std::uint32_t philox_w1 = 0xBB67AE85u;
+
+/** @brief 计数器的第 2、3 个字：流编号与用途 (原始位 / 正态分布的第几次尝试) */
+struct Tweak
+{
+	std::uint32_t stream;
+	std::uint32_t domain;
+};
+
+/**
+ * @brief Philox4x32-10 单块
+ */
+inline std::array<std::uint32_t, 4> philox(std::array<std::uint32_t, 4> c, std::uint32_t k0, std::uint32_t k1) noexcept
+{
+	for(int r = 0; r < 10; ++r)
+	{
+		const std::uint64_t p0 = std::uint64_t {philox_m0} * c[0];
+		const std::uint64_t p1 = std::uint64_t {philox_m1} * c[2];
+		c = {static_cast<std::uint32_t>(p1 >> 32) ^ c[1] ^ k0, static_cast<std::uint32_t>(p1),
+		     static_cast<std::uint32_t>(p0 >> 32) ^ c[3] ^ k1, static_cast<std::uint32_t>(p0)};
+		k0 += philox_w0;
+		k1 += philox_w1;
+	}
+	return c;
+}
+
+#if defined(HYX_RANDOM_AVX2)
+/** @brief 8 路 32x32->64 乘法，分别取高低 32 位 */
+inline void mulhilo8(__m256i a, std::uint32_t m, __m256i& hi, __m256i& lo) noexcept
+{
+	const __m256i mv = _mm256_set1_epi32(static_cast<int>(m));
+	const __m256i even = _mm256_mul_epu32(a, mv);
+	const __m256i odd = _mm256_mul_epu32(_mm256_srli_epi64(a, 32), mv);
+	lo = _mm256_blend_epi32(even, _mm256_slli_epi64(odd, 32), 0xAA);
+	hi = _mm256_blend_epi32(_mm256_srli_epi64(even, 32), odd, 0xAA);
+}
+
+/** @brief 同时计算 8 个块，c[j] 为 8 个块的第 j 个字 */
+inline void philox8(std::uint32_t* c0, std::uint32_t* c1, std::uint32_t* c2, std::uint32_t* c3, std::uint32_t k0, std::uint32_t k1) noexcept
+{
+	__m256i x0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(c0));
+	__m256i x1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(c1));
+	__m256i x2 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(c2));
+	__m256i x3 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(c3));
+	for(int r = 0; r < 10; ++r)
+	{
+		__m256i hi0, lo0, hi1, lo1;
+		mulhilo8(x0, philox_m0, hi0, lo0);
+		mulhilo8(x2, philox_m1, hi1, lo1);
+		x0 = _mm256_xor_si256(_mm256_xor_si256(hi1, x1), _mm256_set1_epi32(static_cast<int>(k0)));
+		x1 = lo1;
+		x2 = _mm256_xor_si256(_mm256_xor_si256(hi0, x3), _mm256_set1_epi32(static_cast<int>(k1)));
+		x3 = lo0;
+		k0 += philox_w0;
+		k1 += philox_w1;
+	}
+	_mm256_storeu_si256(reinterpret_cast<__m256i*>(c0), x0);
+	_mm256_storeu_si256(reinterpret_cast<__m256i*>(c1), x1);
+	_mm256_storeu_si256(reinterpret_cast<__m256i*>(c2), x2);
+	_mm256_storeu_si256(reinterpret_cast<__m256i*>(c3), x3);
+}
+#endif
+
+#if defined(HYX_RANDOM_AVX512)
+inline void mulhilo16(__m512i a, std::uint32_t m, __m512i& hi, __m512i& lo) noexcept
+{
+	const __m512i mv = _mm512_set1_epi32(static_cast<int>(m));
+	const __m512i even = _mm512_mul_epu32(a, mv);
+	const __m512i odd = _mm512_mul_epu32(_mm512_srli_epi64(a, 32), mv);
+	lo = _mm512_mask_blend_epi32(0xAAAA, even, _mm512_slli_epi64(odd, 32));
+	hi = _mm512_mask_blend_epi32(0xAAAA, _mm512_srli_epi64(even, 32), odd);
+}
+
+/** @brief 同时计算 16 个块 */
+inline void philox16(std::uint32_t* c0, std::uint32_t* c1, std::uint32_t* c2, std::uint32_t* c3, std::uint32_t k0, std::uint32_t k1) noexcept
+{
+	__m512i x0 = _mm512_loadu_si512(c0);
+	__m512i x1 = _mm512_loadu_si512(c1);
+	__m512i x2 = _mm512_loadu_si512(c2);
+	__m512i x3 = _mm512_loadu_si512(c3);
+	for(int r = 0; r < 10; ++r)
+	{
+		__m512i hi0, lo0, hi1, lo1;
+		mulhilo16(x0, philox_m0, hi0, lo0);
+		mulhilo16(x2, philox_m1, hi1, lo1);
+		x0 = _mm512_xor_si512(_mm512_xor_si512(hi1, x1), _mm512_set1_epi32(static_cast<int>(k0)));
+		x1 = lo1;
+		x2 = _mm512_xor_si512(_mm512_xor_si512(hi0, x3), _mm512_set1_epi32(static_cast<int>(k1)));
+		x3 = lo0;
+		k0 += philox_w0;
+		k1 += philox_w1;
+	}
+	_mm512_storeu_si512(c0, x0);
+	_mm512_storeu_si512(c1, x1);
+	_mm512_storeu_si512(c2, x2);
+	_mm512_storeu_si512(c3, x3);
+}
+#endif
+
+/**
+ * @brief 计算块号 [first, first + count) 的输出，块 i 的 4 个字写入 out[4i, 4i + 4)
+ */
+inline void philox_blocks(std::uint64_t first, size_t count, Tweak tweak, std::uint32_t k0, std::uint32_t k1, std::uint32_t* out) noexcept
+{
+	size_t i = 0;
+#if defined(HYX_RANDOM_AVX2)
+	constexpr size_t lanes =
+#if defined(HYX_RANDOM_AVX512)
+		16;
+#else
+		8;
+#endif
+	alignas(64) std::uint32_t c0[lanes], c1[lanes], c2[lanes], c3[lanes];
+	for(; i + lanes <= count; i += lanes)
+	{
+		for(size_t j = 0; j < lanes; ++j)
+		{
+			const std::uint64_t b = first + i + j;
+			c0[j] = static_cast<std::uint32_t>(b);
+			c1[j] = static_cast<std::uint32_t>(b >> 32);
+			c2[j] = tweak.stream;
+			c3[j] = tweak.domain;
+		}
+#if defined(HYX_RANDOM_AVX512)
+		philox16(c0, c1, c2, c3, k0, k1);
+#else
+		philox8(c0, c1, c2, c3, k0, k1);
+#endif
+		for(size_t j = 0; j < lanes; ++j)
+		{
+			std::uint32_t* o = out + 4 * (i + j);
+			o[0] = c0[j];
+			o[1] = c1[j];
+			o[2] = c2[j];
+			o[3] = c3[j];
+		}
+	}
+#endif
+	for(; i < count; ++i)
+	{
+		const std::uint64_t b = first + i;
+		const auto r = philox({static_cast<std::uint32_t>(b), static_cast<std::uint32_t>(b >> 32), tweak.stream, tweak.domain}, k0, k1);
+		std::copy_n(r.data(), 4, out + 4 * i);
+	}
+}
+
+/** @brief 高 53 位映射到 [0, 1) */
+[[nodiscard]] inline double to_unit(std::uint64_t x) noexcept
+{
+	return static_cast<double>(x >> 11) * 0x1.0p-53;
+}
+
+/**
+ * @struct Ziggurat
+ * @brief 128 层 Ziggurat 表 (Marsaglia-Tsang，Doornik 的双精度形式)
+ */
+struct Ziggurat
+{
+	static constexpr int layers = 128;
+	static constexpr double r = 3.442619855899;
+	static constexpr double v = 9.91256303526217e-3;
+
+	double x[layers + 1];
+	double ratio[layers];
+
+	Ziggurat() noexcept
+	{
+		const double f = std::exp(-0.5 * r * r);
+		x[0] = v / f;
+		x[1] = r;
+		x[layers] = 0;
+		for(int i = 2; i < layers; ++i)
+			x[i] = std::sqrt(-2 * std::log(v / x[i - 1] + std::exp(-0.5 * x[i - 1] * x[i - 1])));
+		for(int i = 0; i < layers; ++i)
+			ratio[i] = x[i + 1] / x[i];
+	}
+
+	static const Ziggurat& instance() noexcept
+	{
+		static const Ziggurat table;
+		return table;
+	}
+
+	/**
+	 * @brief 以一个块 (两个 64 位字) 尝试一次
+	 * @return 是否接受；接受时写入 out
+	 */
+	[[nodiscard]] bool fast(std::uint64_t a, std::uint64_t b, double& out) const noexcept
+	{
+		const int i = static_cast<int>(a & (layers - 1));
+		const double u = 2 * to_unit(a) - 1;
+		if(std::abs(u) < ratio[i])
+		{
+			out = u * x[i];
+			return true;
+		}
+		if(i == 0) return false; // 尾部交给 slow
+		const double xv = u * x[i];
+		const double f0 = std::exp(-0.5 * (x[i] * x[i] - xv * xv));
+		const double f1 = std::exp(-0.5 * (x[i + 1] * x[i + 1] - xv * xv));
+		if(f1 + to_unit(b) * (f0 - f1) < 1)
+		{
+			out = xv;
+			return true;
+		}
+		return false;
+	}
+};
+
+} // namespace random_details
+
+/**
+ * @class philox_sequence
+ * @brief 基于计数器的随机数列，第 n 项为 Philox4x32-10 的纯函数
+ * @note 原始 64 位项：块 n/2 的第 n%2 个 64 位字；正态分布第 n 项使用块 n 的独立计数器空间，
+ *       被拒绝时依次改用下一个 domain，直到接受。所有成员函数均为 const 且线程安全。
+ *       本对象可直接作为 autoseq<std::uint64_t> 的公式，每次按块生成 block_terms 项
+ */
+class philox_sequence
+{
+public:
+	/** @brief 作为 autoseq 公式时每次生成的项数 */
+	static constexpr size_t block_terms = 512;
+
+	/**
+	 * @param seed 64 位密钥
+	 * @param stream 流编号，不同流之间互相独立
+	 */
+	explicit philox_sequence(std::uint64_t seed, std::uint32_t stream = 0) noexcept
+		: k0_(static_cast<std::uint32_t>(seed)), k1_(static_cast<std::uint32_t>(seed >> 32)), stream_(stream)
+	{
+	}
+
+	[[nodiscard]] std::uint64_t seed() const noexcept
+	{
+		return (std::uint64_t {k1_} << 32) | k0_;
+	}
+
+	[[nodiscard]] std::uint32_t stream() const noexcept
+	{
+		return stream_;
+	}
+
+	/** @brief 第 n 个 64 位随机数，O(1) */
+	[[nodiscard]] std::uint64_t operator[](std::uint64_t n) const noexcept
+	{
+		const std::uint64_t b = n >> 1;
+		const auto r = random_details::philox({static_cast<std::uint32_t>(b), static_cast<std::uint32_t>(b >> 32), stream_, raw_domain}, k0_, k1_);
+		return (n & 1) ? (std::uint64_t {r[3]} << 32) | r[2] : (std::uint64_t {r[1]} << 32) | r[0];
+	}
+
+	/** @brief 第 n 个 [0, 1) 均匀分布，由第 n 个原始项的高 53 位得到 */
+	[[nodiscard]] double uniform(std::uint64_t n) const noexcept
+	{
+		return random_details::to_unit((*this)[n]);
+	}
+
+	/** @brief 第 n 个标准正态分布 */
+	[[nodiscard]] double normal(std::uint64_t n) const noexcept
+	{
+		const auto r = random_details::philox({static_cast<std::uint32_t>(n), static_cast<std::uint32_t>(n >> 32), stream_, normal_domain}, k0_, k1_);
+		double out;
+		if(random_details::Ziggurat::instance().fast(word(r, 0), word(r, 1), out)) return out;
+		return normal_slow(n);
+	}
+
+	/**
+	 * @brief 批量填充第 [first, first + out.size()) 个原始项
+	 */
+	void fill(std::uint64_t first, std::span<std::uint64_t> out) const noexcept
+	{
+		size_t i = 0;
+		if(!out.empty() && (first & 1))
+			out[i++] = (*this)[first];
+
+		std::uint32_t buf[4 * chunk_blocks];
+		while(out.size() - i >= 2)
+		{
+			const size_t blocks = std::min(chunk_blocks, (out.size() - i) / 2);
+			random_details::philox_blocks((first + i) >> 1, blocks, {stream_, raw_domain}, k0_, k1_, buf);
+			for(size_t j = 0; j < 2 * blocks; ++j)
+				out[i + j] = (std::uint64_t {buf[2 * j + 1]} << 32) | buf[2 * j];
+			i += 2 * blocks;
+		}
+		if(i < out.size())
+			out[i] = (*this)[first + i];
+	}
+
+	/**
+	 * @brief 批量填充第 [first, first + out.size()) 个 [0, 1) 均匀分布
+	 */
+	void fill_uniform(std::uint64_t first, std::span<double> out) const noexcept
+	{
+		std::uint64_t raw[2 * chunk_blocks];
+		for(size_t i = 0; i < out.size(); i += 2 * chunk_blocks)
+		{
+			const size_t len = std::min(out.size() - i, 2 * chunk_blocks);
+			fill(first + i, std::span(raw, len));
+			for(size_t j = 0; j < len; ++j)
+				out[i + j] = random_details::to_unit(raw[j]);
+		}
+	}
+
+	/**
+	 * @brief 批量填充第 [first, first + out.size()) 个标准正态分布
+	 * @note 首次尝试按块生成，被拒绝的少数项 (约 1.5%) 再逐个补算
+	 */
+	void fill_normal(std::uint64_t first, std::span<double> out) const noexcept
+	{
+		const auto& zig = random_details::Ziggurat::instance();
+		std::uint32_t buf[4 * chunk_blocks];
+		for(size_t i = 0; i < out.size(); i += chunk_blocks)
+		{
+			const size_t len = std::min(out.size() - i, chunk_blocks);
+			random_details::philox_blocks(first + i, len, {stream_, normal_domain}, k0_, k1_, buf);
+			for(size_t j = 0; j < len; ++j)
+			{
+				const std::uint64_t a = (std::uint64_t {buf[4 * j + 1]} << 32) | buf[4 * j];
+				const std::uint64_t b = (std::uint64_t {buf[4 * j + 3]} << 32) | buf[4 * j + 2];
+				if(!zig.fast(a, b, out[i + j])) out[i + j] = normal_slow(first + i + j);
+			}
+		}
+	}
+
+	/**
+	 * @brief autoseq 公式 (多项输出模式)：从第 n 项起按块生成 block_terms 项
+	 */
+	void operator()(size_t n, std::span<const std::uint64_t>, autoseq_details::TermSink<std::uint64_t>& out) const
+	{
+		std::uint64_t block[block_terms];
+		fill(n, block);
+		for(std::uint64_t v : block)
+			out.emit(v);
+	}
+
+private:
+	static constexpr std::uint32_t raw_domain = 0;
+	/** @brief 正态分布第 k 次尝试使用 normal_domain + k */
+	static constexpr std::uint32_t normal_domain = 1;
+	static constexpr size_t chunk_blocks = 64;
+
+	std::uint32_t k0_, k1_;
+	std::uint32_t stream_;
+
+	[[nodiscard]] static std::uint64_t word(const std::array<std::uint32_t, 4>& r, int i) noexcept
+	{
+		return (std::uint64_t {r[2 * i + 1]} << 32) | r[2 * i];
+	}
+
+	/** @brief 首次尝试被拒绝后的重试与尾部采样，每次使用下一个 domain 的计数器 */
+	[[nodiscard]] double normal_slow(std::uint64_t n) const noexcept
+	{
+		const auto& zig = random_details::Ziggurat::instance();
+		const std::array<std::uint32_t, 4> base = {static_cast<std::uint32_t>(n), static_cast<std::uint32_t>(n >> 32), stream_, normal_domain};
+		const auto first = random_details::philox(base, k0_, k1_);
+		bool tail = (word(first, 0) & (random_details::Ziggurat::layers - 1)) == 0;
+		bool negative = word(first, 0) >> 63;
+		for(std::uint32_t attempt = 1;; ++attempt)
+		{
+			auto c = base;
+			c[3] += attempt;
+			const auto r = random_details::philox(c, k0_, k1_);
+			if(tail)
+			{
+				// 尾部 x > r：Marsaglia 的指数拒绝采样
+				const double x = -std::log(1 - random_details::to_unit(word(r, 0))) / random_details::Ziggurat::r;
+				const double y = -std::log(1 - random_details::to_unit(word(r, 1)));
+				if(2 * y >= x * x) return negative ? -(random_details::Ziggurat::r + x) : random_details::Ziggurat::r + x;
+			}
+			else
+			{
+				double out;
+				if(zig.fast(word(r, 0), word(r, 1), out)) return out;
+				// 重试落在第 0 层且超出矩形部分：与首次尝试相同，转入尾部采样
+				if((word(r, 0) & (random_details::Ziggurat::layers - 1)) == 0)
+				{
+					tail = true;
+					negative = word(r, 0) >> 63;
+				}
+			}
+		}
+	}
+};
+
+} // namespace hyx
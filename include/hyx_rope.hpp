@@ -0,0 +1,368 @@
+#pragma once
+
+#include <version>
+#if __cplusplus < 202302L
+#error "hyx_rope.hpp requires C++23 or later."
+#endif
+
+/**
+ * @file hyx_rope.hpp
+ * @brief 共享子结构的不可变字符串 (rope)，适合 Fibonacci 词、L-system 等自相似字符串数列
+ * @note 节点不可变且以 shared_ptr 共享，拼接只创建 O(|h(a) - h(b)|) 个新节点 (AVL 式合并)，
+ *       因此 autoseq<hyx::rope> 的每一项与之前的项共享结构，整体是一个连接操作的 DAG。
+ *       长度为 uint64，按下标访问为 O(log n)，visit 按块流式遍历任意区间，无需展开整个字符串
+ *
+ * @version 1.0.0
+ * @author Heylyx841
+ * @date 2026-10-18
+ * @license MIT License
+ */
+
+#include <memory>       // std::shared_ptr, std::make_shared
+#include <string>       // std::basic_string, std::char_traits
+#include <string_view>  // std::basic_string_view
+#include <cstdint>      // std::uint64_t
+#include <cstddef>      // size_t
+#include <cassert>      // assert
+#include <algorithm>    // std::max, std::min
+#include <functional>   // std::invoke
+#include <limits>       // std::numeric_limits
+#include <type_traits>  // std::is_same_v, std::invoke_result_t
+#include <utility>      // std::pair, std::move
+#include <ostream>      // std::basic_ostream
+#include <stdexcept>    // std::out_of_range, std::length_error
+
+/**
+ * @namespace hyx
+ */
+namespace hyx
+{
+
+/**
+ * @class basic_rope
+ * @brief 不可变 rope，复制为 O(1)
+ * @note 叶子最多 leaf_capacity 个字符，相邻的短叶子在拼接时合并；内部节点满足 AVL 平衡，
+ *       高度不超过约 1.44 log2(叶子数)
+ */
+template <typename Char, typename Traits = std::char_traits<Char>>
+class basic_rope
+{
+public:
+	using value_type = Char;
+	using size_type = std::uint64_t;
+	using string_type = std::basic_string<Char, Traits>;
+	using string_view_type = std::basic_string_view<Char, Traits>;
+
+	static constexpr size_type npos = std::numeric_limits<size_type>::max();
+	/** @brief 短叶子合并的上限 */
+	static constexpr size_t leaf_capacity = 256;
+
+private:
+	struct Node;
+	using NodePtr = std::shared_ptr<const Node>;
+
+	/** @brief 叶子 (left 为空) 或两个子节点的连接 */
+	struct Node
+	{
+		size_type size = 0;
+		unsigned height = 0;
+		NodePtr left, right;
+		string_type text;
+
+		[[nodiscard]] bool is_leaf() const noexcept
+		{
+			return !left;
+		}
+	};
+
+	NodePtr root_;
+
+	explicit basic_rope(NodePtr root) noexcept
+		: root_(std::move(root))
+	{
+	}
+
+	[[nodiscard]] static unsigned height(const NodePtr& n) noexcept
+	{
+		return n ? n->height : 0;
+	}
+
+	[[nodiscard]] static NodePtr make_leaf(string_type text)
+	{
+		if(text.empty()) return nullptr;
+		auto n = std::make_shared<Node>();
+		n->size = text.size();
+		n->text = std::move(text);
+		return n;
+	}
+
+	[[nodiscard]] static NodePtr make_concat(NodePtr a, NodePtr b)
+	{
+		if(b->size > std::numeric_limits<size_type>::max() - a->size) [[unlikely]]
+			throw std::length_error("hyx::rope: Length exceeds uint64.");
+		auto n = std::make_shared<Node>();
+		n->size = a->size + b->size;
+		n->height = std::max(a->height, b->height) + 1;
+		n->left = std::move(a);
+		n->right = std::move(b);
+		return n;
+	}
+
+	/** @brief (x, (y, z)) -> ((x, y), z) */
+	[[nodiscard]] static NodePtr rotate_left(const NodePtr& n)
+	{
+		return make_concat(make_concat(n->left, n->right->left), n->right->right);
+	}
+
+	/** @brief ((x, y), z) -> (x, (y, z)) */
+	[[nodiscard]] static NodePtr rotate_right(const NodePtr& n)
+	{
+		return make_concat(n->left->left, make_concat(n->left->right, n->right));
+	}
+
+	/** @brief h(a) > h(b) + 1：沿 a 的右脊下降到高度相当处再逐层旋转回来 */
+	[[nodiscard]] static NodePtr join_right(const NodePtr& a, const NodePtr& b)
+	{
+		const NodePtr& l = a->left;
+		const NodePtr& c = a->right;
+		NodePtr t = height(c) <= height(b) + 1 ? join(c, b) : join_right(c, b);
+		if(height(t) <= height(l) + 1) return make_concat(l, std::move(t));
+		if(height(t->left) > height(t->right)) t = rotate_right(t);
+		return rotate_left(make_concat(l, std::move(t)));
+	}
+
+	/** @brief h(b) > h(a) + 1：与 join_right 对称 */
+	[[nodiscard]] static NodePtr join_left(const NodePtr& a, const NodePtr& b)
+	{
+		const NodePtr& c = b->left;
+		const NodePtr& r = b->right;
+		NodePtr t = height(c) <= height(a) + 1 ? join(a, c) : join_left(a, c);
+		if(height(t) <= height(r) + 1) return make_concat(std::move(t), r);
+		if(height(t->right) > height(t->left)) t = rotate_left(t);
+		return rotate_right(make_concat(std::move(t), r));
+	}
+
+	/** @brief 保持 AVL 平衡的拼接，高度相近时直接共享两侧 */
+	[[nodiscard]] static NodePtr join(const NodePtr& a, const NodePtr& b)
+	{
+		if(!a) return b;
+		if(!b) return a;
+		if(a->is_leaf() && b->is_leaf() && a->size + b->size <= leaf_capacity)
+			return make_leaf(a->text + b->text);
+		if(a->height > b->height + 1) return join_right(a, b);
+		if(b->height > a->height + 1) return join_left(a, b);
+		return make_concat(a, b);
+	}
+
+	/** @brief 拆成 [0, pos) 与 [pos, size) */
+	[[nodiscard]] static std::pair<NodePtr, NodePtr> split(const NodePtr& n, size_type pos)
+	{
+		if(!n || pos == 0) return {nullptr, n};
+		if(pos >= n->size) return {n, nullptr};
+		if(n->is_leaf())
+		{
+			const auto p = static_cast<size_t>(pos);
+			return {make_leaf(n->text.substr(0, p)), make_leaf(n->text.substr(p))};
+		}
+		const size_type ls = n->left->size;
+		if(pos <= ls)
+		{
+			auto [a, b] = split(n->left, pos);
+			return {std::move(a), join(b, n->right)};
+		}
+		auto [a, b] = split(n->right, pos - ls);
+		return {join(n->left, a), std::move(b)};
+	}
+
+	/** @brief 按顺序把 [pos, pos + count) 内的叶子片段交给 f，f 返回 false 时停止 */
+	template <typename F>
+	static bool visit_node(const Node* n, size_type pos, size_type count, F& f)
+	{
+		while(!n->is_leaf())
+		{
+			const size_type ls = n->left->size;
+			if(pos + count <= ls)
+			{
+				n = n->left.get();
+			}
+			else if(pos >= ls)
+			{
+				pos -= ls;
+				n = n->right.get();
+			}
+			else
+			{
+				if(!visit_node(n->left.get(), pos, ls - pos, f)) return false;
+				count -= ls - pos;
+				pos = 0;
+				n = n->right.get();
+			}
+		}
+		const string_view_type piece = string_view_type(n->text).substr(static_cast<size_t>(pos), static_cast<size_t>(count));
+		if constexpr(std::is_same_v<std::invoke_result_t<F&, string_view_type>, bool>)
+			return std::invoke(f, piece);
+		else
+			return std::invoke(f, piece), true;
+	}
+
+public:
+	basic_rope() noexcept = default;
+
+	basic_rope(string_view_type s)
+	{
+		// 长文本切成多个叶子，避免单个叶子过大导致 substr / 合并时整体复制
+		for(size_t i = 0; i < s.size(); i += 16 * leaf_capacity)
+			root_ = join(root_, make_leaf(string_type(s.substr(i, 16 * leaf_capacity))));
+	}
+
+	basic_rope(const Char* s)
+		: basic_rope(string_view_type(s))
+	{
+	}
+
+	basic_rope(const string_type& s)
+		: basic_rope(string_view_type(s))
+	{
+	}
+
+	[[nodiscard]] size_type size() const noexcept
+	{
+		return root_ ? root_->size : 0;
+	}
+
+	[[nodiscard]] bool empty() const noexcept
+	{
+		return !root_;
+	}
+
+	/** @brief 连接节点的层数，叶子为 0 */
+	[[nodiscard]] unsigned depth() const noexcept
+	{
+		return height(root_);
+	}
+
+	/**
+	 * @brief 第 i 个字符，O(depth)
+	 * @note 要求 i < size()，空串上没有可读的字符；需要检查时请用 at()
+	 */
+	[[nodiscard]] Char operator[](size_type i) const noexcept
+	{
+		assert(i < size() && "hyx::rope: Index out of range.");
+		const Node* n = root_.get();
+		while(!n->is_leaf())
+		{
+			const size_type ls = n->left->size;
+			if(i < ls)
+			{
+				n = n->left.get();
+			}
+			else
+			{
+				i -= ls;
+				n = n->right.get();
+			}
+		}
+		return n->text[static_cast<size_t>(i)];
+	}
+
+	/**
+	 * @brief 带边界检查访问第 i 个字符
+	 */
+	[[nodiscard]] Char at(size_type i) const
+	{
+		if(i >= size()) [[unlikely]]
+			throw std::out_of_range("hyx::rope: Index out of range.");
+		return (*this)[i];
+	}
+
+	/**
+	 * @brief 子串 [pos, pos + count)，与原 rope 共享除边界外的全部节点
+	 * @throws std::out_of_range pos > size()
+	 */
+	[[nodiscard]] basic_rope substr(size_type pos, size_type count = npos) const
+	{
+		if(pos > size()) [[unlikely]]
+			throw std::out_of_range("hyx::rope: Substring position out of range.");
+		count = std::min(count, size() - pos);
+		auto [head, rest] = split(root_, pos);
+		return basic_rope(split(rest, count).first);
+	}
+
+	/**
+	 * @brief 流式遍历 [pos, pos + count)，依次以 string_view 形式交出各个片段
+	 * @param f void(string_view) 或 bool(string_view)，返回 false 时提前结束
+	 */
+	template <typename F>
+	void visit(size_type pos, size_type count, F&& f) const
+	{
+		if(pos >= size()) return;
+		count = std::min(count, size() - pos);
+		if(count == 0) return;
+		visit_node(root_.get(), pos, count, f);
+	}
+
+	template <typename F>
+	void visit(F&& f) const
+	{
+		visit(0, npos, f);
+	}
+
+	/**
+	 * @brief 展开 [pos, pos + count) 为字符串
+	 * @throws std::length_error 区间超出 string 的最大长度
+	 */
+	[[nodiscard]] string_type str(size_type pos = 0, size_type count = npos) const
+	{
+		if(pos >= size()) return {};
+		count = std::min(count, size() - pos);
+		string_type out;
+		if(count > out.max_size()) [[unlikely]]
+			throw std::length_error("hyx::rope: Range too large to materialize.");
+		out.reserve(static_cast<size_t>(count));
+		visit(pos, count, [&](string_view_type piece) { out.append(piece); });
+		return out;
+	}
+
+	basic_rope& operator+=(const basic_rope& other)
+	{
+		root_ = join(root_, other.root_);
+		return *this;
+	}
+
+	[[nodiscard]] friend basic_rope operator+(const basic_rope& a, const basic_rope& b)
+	{
+		return basic_rope(join(a.root_, b.root_));
+	}
+
+	/** @brief 逐字符比较；共享同一节点时为 O(1) */
+	[[nodiscard]] friend bool operator==(const basic_rope& a, const basic_rope& b)
+	{
+		if(a.root_ == b.root_) return true;
+		if(a.size() != b.size()) return false;
+		size_type offset = 0;
+		bool equal = true;
+		a.visit([&](string_view_type piece)
+		{
+			const size_type len = piece.size();
+			b.visit(offset, len, [&](string_view_type other)
+			{
+				equal = piece.substr(0, other.size()) == other;
+				piece.remove_prefix(other.size());
+				return equal;
+			});
+			offset += len;
+			return equal;
+		});
+		return equal;
+	}
+
+	friend std::basic_ostream<Char, Traits>& operator<<(std::basic_ostream<Char, Traits>& os, const basic_rope& r)
+	{
+		r.visit([&](string_view_type piece) { os << piece; });
+		return os;
+	}
+};
+
+using rope = basic_rope<char>;
+
+} // namespace hyx
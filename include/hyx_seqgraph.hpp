@@ -0,0 +1,421 @@
+#pragma once
+
+#include <version>
+#if __cplusplus < 202302L
+#error "hyx_seqgraph.hpp requires C++23 or later."
+#endif
+
+/**
+ * @file hyx_seqgraph.hpp
+ * @brief 相互依赖的 autoseq 网络的并行调度
+ * @note 每个节点声明它读取哪些输入以及读到输入的哪个位置；prefetch 先反向推算每个节点需要的长度，
+ *       再把节点扩展作为任务图交给工作窃取线程池：互不依赖的数列并行扩展，
+ *       每个节点只等待它真正需要的输入前缀完成
+ *
+ * @version 1.0.0
+ * @author Heylyx841
+ * @date 2026-10-18
+ * @license MIT License
+ */
+
+#include <vector>       // std::vector
+#include <deque>        // std::deque
+#include <functional>   // std::function
+#include <thread>       // std::jthread, std::thread::hardware_concurrency
+#include <mutex>        // std::mutex, std::lock_guard, std::unique_lock
+#include <condition_variable> // std::condition_variable
+#include <memory>       // std::unique_ptr, std::make_unique
+#include <utility>      // std::exchange
+#include <atomic>       // std::atomic
+#include <exception>    // std::exception_ptr, std::current_exception, std::rethrow_exception
+#include <optional>     // std::optional
+#include <limits>       // std::numeric_limits
+#include <algorithm>    // std::max, std::min, std::clamp
+#include <cstddef>      // size_t, std::ptrdiff_t
+#include <stdexcept>    // std::invalid_argument
+
+/**
+ * @namespace hyx
+ */
+namespace hyx
+{
+
+/**
+ * @namespace seqgraph_details
+ * @brief 内部实现细节
+ */
+namespace seqgraph_details
+{
+
+/**
+ * @class StealPool
+ * @brief 可复用的工作窃取执行器
+ * @note 工作线程在构造时启动，在两次 run 之间休眠，析构时退出。每个工作线程优先从自己队列尾部取任务，
+ *       空闲时从其它队列头部窃取；调用线程作为 0 号工作线程参与执行
+ */
+class StealPool
+{
+public:
+	/**
+	 * @param workers 工作线程数 (含调用线程)
+	 * @note 中途无法启动线程时，先让已启动的线程退出再抛出，不会在析构时互相等待
+	 */
+	explicit StealPool(size_t workers)
+		: queues_(std::max<size_t>(1, workers))
+	{
+		threads_.reserve(queues_.size() - 1);
+		try
+		{
+			for(size_t w = 1; w < queues_.size(); ++w)
+				threads_.emplace_back([this, w] { serve(w); });
+		}
+		catch(...)
+		{
+			shutdown();
+			throw;
+		}
+	}
+
+	StealPool(const StealPool&) = delete;
+	StealPool& operator=(const StealPool&) = delete;
+
+	~StealPool()
+	{
+		shutdown();
+	}
+
+	/** @brief 工作线程数 (含调用线程) */
+	[[nodiscard]] size_t workers() const noexcept
+	{
+		return queues_.size();
+	}
+
+	/** @brief 在 worker 的队列中加入就绪任务 */
+	void push(size_t worker, size_t task)
+	{
+		{
+			std::lock_guard lock(queues_[worker].mutex);
+			queues_[worker].tasks.push_back(task);
+		}
+		signal();
+	}
+
+	/**
+	 * @brief 执行到所有任务完成或某个任务抛出异常
+	 * @param total 需要执行的任务总数
+	 * @param active 参与本轮的工作线程数 (含调用线程)，其余线程继续休眠
+	 * @param execute void(size_t worker, size_t task)，可在其中 push 后继任务
+	 */
+	template <typename Execute>
+	void run(size_t total, size_t active, Execute&& execute)
+	{
+		active = std::clamp<size_t>(active, 1, queues_.size());
+		execute_ = [&execute](size_t worker, size_t task) { execute(worker, task); };
+		remaining_.store(total, std::memory_order_relaxed);
+		failed_.store(false, std::memory_order_relaxed);
+		{
+			std::lock_guard lock(job_mutex_);
+			active_ = active;
+			busy_ = active - 1;
+			++job_;
+		}
+		job_cv_.notify_all();
+
+		work(0);
+		{
+			std::unique_lock lock(job_mutex_);
+			idle_cv_.wait(lock, [this] { return busy_ == 0; });
+		}
+
+		// 失败时队列中可能留有未执行的任务，清空后供下一轮使用
+		for(auto& q : queues_)
+			q.tasks.clear();
+		execute_ = nullptr;
+		if(auto error = std::exchange(error_, nullptr)) std::rethrow_exception(error);
+	}
+
+private:
+	struct Queue
+	{
+		std::mutex mutex;
+		std::deque<size_t> tasks;
+	};
+
+	std::vector<Queue> queues_;
+	std::function<void(size_t, size_t)> execute_;
+	std::atomic<size_t> remaining_{0};
+	std::atomic<size_t> epoch_{0};
+	std::atomic<bool> failed_{false};
+	std::exception_ptr error_;
+	std::mutex error_mutex_;
+
+	/** @brief 以下四项由 job_mutex_ 保护：本轮编号、参与线程数、尚未退出本轮的工作线程数、是否退出 */
+	std::mutex job_mutex_;
+	std::condition_variable job_cv_;
+	std::condition_variable idle_cv_;
+	size_t job_ = 0;
+	size_t active_ = 0;
+	size_t busy_ = 0;
+	bool stopping_ = false;
+
+	/** @brief 最后声明，析构时其余成员仍然有效 */
+	std::vector<std::jthread> threads_;
+
+	void shutdown() noexcept
+	{
+		{
+			std::lock_guard lock(job_mutex_);
+			stopping_ = true;
+		}
+		job_cv_.notify_all();
+		threads_.clear();
+	}
+
+	/** @brief 工作线程主循环：等待新一轮，参与时执行到本轮结束 */
+	void serve(size_t worker)
+	{
+		size_t seen = 0;
+		while(true)
+		{
+			{
+				std::unique_lock lock(job_mutex_);
+				job_cv_.wait(lock, [&] { return stopping_ || job_ != seen; });
+				if(stopping_) return;
+				seen = job_;
+				if(worker >= active_) continue;
+			}
+			work(worker);
+			std::lock_guard lock(job_mutex_);
+			if(--busy_ == 0) idle_cv_.notify_all();
+		}
+	}
+
+	void signal() noexcept
+	{
+		epoch_.fetch_add(1, std::memory_order_release);
+		epoch_.notify_all();
+	}
+
+	[[nodiscard]] std::optional<size_t> pop(size_t worker)
+	{
+		{
+			auto& own = queues_[worker];
+			std::lock_guard lock(own.mutex);
+			if(!own.tasks.empty())
+			{
+				const size_t task = own.tasks.back();
+				own.tasks.pop_back();
+				return task;
+			}
+		}
+		for(size_t i = 1; i < queues_.size(); ++i)
+		{
+			auto& victim = queues_[(worker + i) % queues_.size()];
+			std::lock_guard lock(victim.mutex);
+			if(!victim.tasks.empty())
+			{
+				const size_t task = victim.tasks.front();
+				victim.tasks.pop_front();
+				return task;
+			}
+		}
+		return std::nullopt;
+	}
+
+	void work(size_t worker)
+	{
+		while(true)
+		{
+			// 先读取 epoch 再检查完成状态并尝试取任务，避免错过两者之间发生的 push 或完成通知
+			const size_t seen = epoch_.load(std::memory_order_acquire);
+			if(remaining_.load(std::memory_order_acquire) == 0 || failed_.load(std::memory_order_acquire))
+				return;
+			if(auto task = pop(worker))
+			{
+				try
+				{
+					execute_(worker, *task);
+				}
+				catch(...)
+				{
+					std::lock_guard lock(error_mutex_);
+					if(!error_) error_ = std::current_exception();
+					failed_.store(true, std::memory_order_release);
+				}
+				remaining_.fetch_sub(1, std::memory_order_acq_rel);
+				signal();
+			}
+			else
+			{
+				epoch_.wait(seen, std::memory_order_acquire);
+			}
+		}
+	}
+};
+
+} // namespace seqgraph_details
+
+/**
+ * @class seqgraph
+ * @brief 数列依赖图
+ * @note 只保存数列的引用，数列必须比图活得更久。节点公式只能读取声明过的输入；
+ *       prefetch 期间图中的数列不得被其它线程访问，也不要启用自适应调优。
+ *       工作线程在首次 prefetch 时启动并一直复用到图析构，因此图只能移动不能复制
+ */
+class seqgraph
+{
+public:
+	using node_id = size_t;
+
+	/**
+	 * @brief 一条输入边：节点第 n 项最多读取输入的第 scale * n + offset 项
+	 * @note 例如 y[n - 1] 对应 offset = -1，y[2n + 1] 对应 scale = 2, offset = 1
+	 */
+	struct input
+	{
+		node_id node;
+		std::ptrdiff_t offset = 0;
+		size_t scale = 1;
+	};
+
+	/**
+	 * @brief 加入一个节点
+	 * @param seq autoseq 或任何提供 prefetch_up_to / size 的数列
+	 * @param inputs 已加入的节点，因此加入顺序天然是拓扑序，不会成环
+	 */
+	template <typename Seq>
+	requires requires(const Seq& s) { s.prefetch_up_to(size_t{}); s.size(); }
+	node_id add(const Seq& seq, std::vector<input> inputs = {})
+	{
+		for(const auto& in : inputs)
+		{
+			if(in.node >= nodes_.size()) [[unlikely]]
+				throw std::invalid_argument("hyx::seqgraph: Input must be added before its consumer.");
+		}
+		nodes_.push_back({
+			[&seq](size_t n) { seq.prefetch_up_to(n); },
+			[&seq] { return static_cast<size_t>(seq.size()); },
+			std::move(inputs)
+		});
+		return nodes_.size() - 1;
+	}
+
+	/** @brief 节点数 */
+	[[nodiscard]] size_t size() const noexcept
+	{
+		return nodes_.size();
+	}
+
+	/**
+	 * @brief 并行缓存 target 到第 n 项，以及它传递依赖的全部前缀
+	 * @param threads 工作线程数 (含调用线程)，0 表示 hardware_concurrency
+	 */
+	void prefetch(node_id target, size_t n, size_t threads = 0)
+	{
+		if(target >= nodes_.size()) [[unlikely]]
+			throw std::invalid_argument("hyx::seqgraph: Unknown node.");
+
+		constexpr size_t none = std::numeric_limits<size_t>::max();
+
+		// 反向推算每个节点需要缓存到的索引 (加入顺序即拓扑序)
+		std::vector<size_t> need(target + 1, none);
+		need[target] = n;
+		for(size_t id = target + 1; id-- > 0;)
+		{
+			if(need[id] == none) continue;
+			for(const auto& in : nodes_[id].inputs)
+			{
+				const auto reach = required(need[id], in);
+				if(reach && (need[in.node] == none || *reach > need[in.node]))
+					need[in.node] = *reach;
+			}
+		}
+
+		// 任务：尚未缓存到位的节点；依赖：同为任务的输入
+		std::vector<bool> is_task(target + 1, false);
+		size_t total = 0;
+		for(size_t id = 0; id <= target; ++id)
+		{
+			if(need[id] != none && nodes_[id].cached() <= need[id])
+			{
+				is_task[id] = true;
+				++total;
+			}
+		}
+		if(total == 0) return;
+
+		std::vector<std::vector<node_id>> dependents(target + 1);
+		std::vector<std::atomic<size_t>> pending(target + 1);
+		for(size_t id = 0; id <= target; ++id)
+		{
+			if(!is_task[id]) continue;
+			std::vector<node_id> deps;
+			for(const auto& in : nodes_[id].inputs)
+			{
+				if(is_task[in.node] && std::find(deps.begin(), deps.end(), in.node) == deps.end())
+					deps.push_back(in.node);
+			}
+			pending[id].store(deps.size(), std::memory_order_relaxed);
+			for(node_id d : deps)
+				dependents[d].push_back(id);
+		}
+
+		if(threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+		const size_t active = std::min(threads, total);
+		// 线程池跨 prefetch 复用，只在需要更多线程时重建
+		if(!pool_ || pool_->workers() < active)
+		{
+			pool_.reset();
+			pool_ = std::make_unique<seqgraph_details::StealPool>(active);
+		}
+		auto& pool = *pool_;
+
+		size_t next = 0;
+		for(size_t id = 0; id <= target; ++id)
+		{
+			if(is_task[id] && pending[id].load(std::memory_order_relaxed) == 0)
+				pool.push(next++ % active, id);
+		}
+
+		pool.run(total, active, [&](size_t worker, size_t id)
+		{
+			nodes_[id].extend(need[id]);
+			for(node_id d : dependents[id])
+			{
+				// 最后一个完成的输入负责发布后继，acq_rel 保证后继看到全部输入的写入
+				if(pending[d].fetch_sub(1, std::memory_order_acq_rel) == 1)
+					pool.push(worker, d);
+			}
+		});
+	}
+
+private:
+	struct Node
+	{
+		std::function<void(size_t)> extend;
+		std::function<size_t()> cached;
+		std::vector<input> inputs;
+	};
+
+	std::vector<Node> nodes_;
+	/** @brief 首次并行 prefetch 时创建，之后复用 */
+	std::unique_ptr<seqgraph_details::StealPool> pool_;
+
+	/** @brief 节点需要到第 n 项时对输入的需求，不需要时为空 */
+	[[nodiscard]] static std::optional<size_t> required(size_t n, const input& in) noexcept
+	{
+		constexpr size_t max = std::numeric_limits<size_t>::max();
+		if(in.scale != 0 && n > max / in.scale) return max - 1;
+		const size_t scaled = n * in.scale;
+		if(in.offset >= 0)
+		{
+			const size_t add = static_cast<size_t>(in.offset);
+			return scaled > max - 1 - add ? max - 1 : scaled + add;
+		}
+		const size_t sub = static_cast<size_t>(-(in.offset + 1)) + 1;
+		if(scaled < sub) return std::nullopt;
+		return scaled - sub;
+	}
+};
+
+} // namespace hyx
@@ -0,0 +1,444 @@
+#pragma once
+
+#include <version>
+#if __cplusplus < 202302L
+#error "hyx_shard.hpp requires C++23 or later."
+#endif
+
+/**
+ * @file hyx_shard.hpp
+ * @brief 多进程分片生成与历史无关的数列前缀
+ * @note 父进程 fork 出若干工作进程，各自领取互不相交的索引块，把结果直接写入共享映射 (匿名或缓存文件)；
+ *       领取块的大小随剩余量递减 (guided 调度)，单项代价不均时慢的进程自然少领。
+ *       结果可经 hyx::adopt_prefix 交给 autoseq。非 POSIX 平台退化为在本进程内顺序计算
+ *
+ * @version 1.0.0
+ * @author Heylyx841
+ * @date 2026-10-18
+ * @license MIT License
+ */
+
+#include <atomic>       // std::atomic
+#include <span>         // std::span
+#include <string>       // std::string
+#include <filesystem>   // std::filesystem::path
+#include <functional>   // std::invoke
+#include <thread>       // std::thread::hardware_concurrency
+#include <vector>       // std::vector
+#include <new>          // placement new, std::bad_alloc, ::operator new
+#include <memory>       // std::start_lifetime_as_array
+#include <utility>      // std::exchange
+#include <limits>       // std::numeric_limits
+#include <algorithm>    // std::max, std::min
+#include <cstdint>      // std::uint64_t
+#include <cstddef>      // size_t
+#include <type_traits>  // std::is_trivially_copyable_v, std::is_invocable_r_v
+#include <stdexcept>    // std::runtime_error, std::length_error, std::invalid_argument
+#include <system_error> // std::system_error
+#include <exception>    // std::exception_ptr, std::rethrow_exception
+#include <cstring>      // std::memcpy
+
+#if defined(__unix__) || defined(__APPLE__)
+#define HYX_SHARD_FORK 1
+#include <sys/mman.h>   // mmap, munmap
+#include <sys/stat.h>   // fstat
+#include <sys/wait.h>   // waitpid
+#include <fcntl.h>      // open
+#include <unistd.h>     // fork, _exit, ftruncate, close, unlink
+#include <cerrno>       // errno, EINTR
+#include <cstdio>       // std::rename
+#endif
+
+/**
+ * @namespace hyx
+ */
+namespace hyx
+{
+
+/**
+ * @brief 分片生成选项
+ */
+struct shard_options
+{
+	/** @brief 参与计算的进程数 (含父进程)，0 表示 hardware_concurrency */
+	size_t workers = 0;
+	/** @brief 每次领取的最少项数，单项越贵越应取小 */
+	size_t grain = 16;
+	/**
+	 * @brief 缓存文件，为空时使用匿名共享映射
+	 * @note 文件以 64 字节的文件头 (魔数、格式版本、项大小、项数、key) 开始，其后是按本机字节序排列的原始项；
+	 *       已存在、文件头与本次调用一致且项数足够时直接映射，不再计算，否则重新生成并覆盖。
+	 *       生成过程写入 <file>.part，成功后才改名
+	 */
+	std::filesystem::path file = {};
+	/**
+	 * @brief 缓存文件的校验键，记录在文件头中
+	 * @note 公式或其参数 (如随机种子) 改变时应换一个值，旧文件因此不会被误用
+	 */
+	std::uint64_t key = 0;
+};
+
+/**
+ * @namespace shard_details
+ * @brief 内部实现细节
+ */
+namespace shard_details
+{
+
+/** @brief 放在独立共享页中的调度状态，结果区因此保持为纯数据 */
+struct Control
+{
+	std::atomic<std::uint64_t> next{0};
+	std::atomic<bool> failed{false};
+};
+
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free && std::atomic<bool>::is_always_lock_free,
+              "Cross-process scheduling requires lock-free atomics.");
+
+/** @brief 缓存文件头，结果区紧随其后；长度兼作结果区的对齐 */
+struct alignas(64) FileHeader
+{
+	/** @brief 按本机字节序读出的 "HYXSHARD"，字节序不同的文件同样被拒绝 */
+	static constexpr std::uint64_t magic_value = 0x4452414853585948;
+	static constexpr std::uint32_t current_version = 1;
+
+	std::uint64_t magic = magic_value;
+	std::uint32_t version = current_version;
+	std::uint32_t term_size = 0;
+	std::uint64_t count = 0;
+	std::uint64_t key = 0;
+};
+
+/**
+ * @brief 已有的缓存文件能否用于本次调用
+ * @param file_size 文件长度，用于确认文件头声明的项确实都在文件中
+ */
+inline bool accept_header(const FileHeader& h, size_t term_size, size_t count, std::uint64_t key, size_t file_size) noexcept
+{
+	return h.magic == FileHeader::magic_value && h.version == FileHeader::current_version &&
+	       h.term_size == term_size && h.key == key && h.count >= count &&
+	       h.count <= (file_size - sizeof(FileHeader)) / term_size;
+}
+
+/**
+ * @brief 领取下一个索引块 [first, last)
+ * @return 没有剩余或已有进程失败时返回 false
+ */
+inline bool claim(Control& ctl, size_t count, size_t workers, size_t grain, size_t& first, size_t& last) noexcept
+{
+	std::uint64_t cur = ctl.next.load(std::memory_order_relaxed);
+	while(true)
+	{
+		if(cur >= count || ctl.failed.load(std::memory_order_relaxed)) return false;
+		const size_t remaining = count - static_cast<size_t>(cur);
+		const size_t take = std::min(remaining, std::max(grain, remaining / (2 * workers)));
+		if(ctl.next.compare_exchange_weak(cur, cur + take, std::memory_order_relaxed))
+		{
+			first = static_cast<size_t>(cur);
+			last = first + take;
+			return true;
+		}
+	}
+}
+
+/** @brief 反复领取并计算，直到没有剩余；异常时标记失败后继续抛出 */
+template <typename T, typename F>
+void drain(Control& ctl, T* out, size_t count, size_t workers, size_t grain, F& term)
+{
+	size_t first = 0, last = 0;
+	try
+	{
+		while(claim(ctl, count, workers, grain, first, last))
+		{
+			for(size_t i = first; i < last; ++i)
+				::new(static_cast<void*>(out + i)) T(std::invoke(term, i));
+		}
+	}
+	catch(...)
+	{
+		ctl.failed.store(true, std::memory_order_relaxed);
+		throw;
+	}
+}
+
+} // namespace shard_details
+
+template <typename T>
+requires std::is_trivially_copyable_v<T>
+class shard_prefix;
+
+template <typename T, typename F>
+requires std::is_trivially_copyable_v<T> && std::is_invocable_r_v<T, F&, size_t>
+[[nodiscard]] shard_prefix<T> shard_generate(size_t count, F&& term, const shard_options& options = {});
+
+/**
+ * @class shard_prefix
+ * @brief 分片生成的结果，持有共享映射
+ * @note 通过 terms() 交给 autoseq(hyx::adopt_prefix, ...) 时，本对象必须比 autoseq 活得更久
+ *
+ * @tparam T 元素类型
+ */
+template <typename T>
+requires std::is_trivially_copyable_v<T>
+class shard_prefix
+{
+public:
+	shard_prefix() noexcept = default;
+
+	shard_prefix(shard_prefix&& other) noexcept
+		: map_(std::exchange(other.map_, nullptr))
+		, data_(std::exchange(other.data_, nullptr))
+		, size_(std::exchange(other.size_, 0))
+		, bytes_(std::exchange(other.bytes_, 0))
+	{
+	}
+
+	shard_prefix& operator=(shard_prefix&& other) noexcept
+	{
+		if(this != &other)
+		{
+			release();
+			map_ = std::exchange(other.map_, nullptr);
+			data_ = std::exchange(other.data_, nullptr);
+			size_ = std::exchange(other.size_, 0);
+			bytes_ = std::exchange(other.bytes_, 0);
+		}
+		return *this;
+	}
+
+	~shard_prefix()
+	{
+		release();
+	}
+
+	/** @brief 生成的前缀 */
+	[[nodiscard]] std::span<const T> terms() const noexcept
+	{
+		return {data_, size_};
+	}
+
+	[[nodiscard]] size_t size() const noexcept
+	{
+		return size_;
+	}
+
+private:
+	template <typename U, typename F>
+	requires std::is_trivially_copyable_v<U> && std::is_invocable_r_v<U, F&, size_t>
+	friend shard_prefix<U> shard_generate(size_t, F&&, const shard_options&);
+
+	/** @brief 映射起点；缓存文件的映射以文件头开始，结果区位于 offset 处 */
+	void* map_ = nullptr;
+	const T* data_ = nullptr;
+	size_t size_ = 0;
+	/** @brief 映射长度；非 POSIX 平台上是堆分配的字节数 */
+	size_t bytes_ = 0;
+
+	shard_prefix(void* map, size_t offset, size_t count, size_t bytes) noexcept
+		: map_(map), size_(count), bytes_(bytes)
+	{
+		void* base = static_cast<unsigned char*>(map) + offset;
+#if defined(__cpp_lib_start_lifetime_as)
+		data_ = std::start_lifetime_as_array<T>(base, count);
+#else
+		data_ = static_cast<const T*>(base);
+#endif
+	}
+
+	void release() noexcept
+	{
+		if(!map_) return;
+#if defined(HYX_SHARD_FORK)
+		::munmap(map_, bytes_);
+#else
+		::operator delete(map_, bytes_, std::align_val_t{alignof(T)});
+#endif
+		map_ = nullptr;
+		data_ = nullptr;
+	}
+};
+
+/**
+ * @brief 以多个进程并行计算第 [0, count) 项
+ * @param term T(size_t)，只依赖索引；在子进程中调用，不得依赖父进程的其它线程或持有的锁
+ * @throws std::system_error 映射或文件操作失败
+ * @throws std::invalid_argument 使用缓存文件且 T 的对齐超过文件头长度 (64 字节)
+ * @throws std::runtime_error 任一进程中公式抛出异常或异常退出
+ * @note 子进程不执行析构与 atexit 处理；父进程也参与计算，fork 失败时由已有进程分担剩余部分
+ */
+template <typename T, typename F>
+requires std::is_trivially_copyable_v<T> && std::is_invocable_r_v<T, F&, size_t>
+shard_prefix<T> shard_generate(size_t count, F&& term, const shard_options& options)
+{
+	if(count == 0) return {};
+	if(count > std::numeric_limits<size_t>::max() / sizeof(T)) [[unlikely]]
+		throw std::length_error("hyx::shard_generate: Prefix too large.");
+
+	const size_t bytes = count * sizeof(T);
+	const size_t workers = options.workers ? options.workers : std::max(1u, std::thread::hardware_concurrency());
+	const size_t grain = std::max<size_t>(1, options.grain);
+
+#if defined(HYX_SHARD_FORK)
+	const auto fail = [](const char* what) -> void
+	{
+		throw std::system_error(errno, std::generic_category(), std::string("hyx::shard_generate: ") + what);
+	};
+
+	// 缓存文件以文件头开始，结果区紧随其后
+	constexpr size_t header_bytes = sizeof(shard_details::FileHeader);
+	const size_t offset = options.file.empty() ? 0 : header_bytes;
+	if(offset && alignof(T) > header_bytes) [[unlikely]]
+		throw std::invalid_argument("hyx::shard_generate: Term alignment exceeds the cache file header.");
+	if(bytes > std::numeric_limits<size_t>::max() - offset) [[unlikely]]
+		throw std::length_error("hyx::shard_generate: Prefix too large.");
+	const size_t mapped = offset + bytes;
+
+	// 命中缓存文件：文件头一致时直接只读映射
+	const std::string part = options.file.empty() ? std::string() : options.file.string() + ".part";
+	if(!options.file.empty())
+	{
+		const int fd = ::open(options.file.c_str(), O_RDONLY | O_CLOEXEC);
+		if(fd >= 0)
+		{
+			struct stat st{};
+			void* base = MAP_FAILED;
+			if(::fstat(fd, &st) == 0 && static_cast<size_t>(st.st_size) >= mapped)
+				base = ::mmap(nullptr, mapped, PROT_READ, MAP_SHARED, fd, 0);
+			::close(fd);
+			if(base != MAP_FAILED)
+			{
+				shard_details::FileHeader header;
+				std::memcpy(&header, base, header_bytes);
+				if(shard_details::accept_header(header, sizeof(T), count, options.key, static_cast<size_t>(st.st_size)))
+					return shard_prefix<T>(base, offset, count, mapped);
+				::munmap(base, mapped);
+			}
+		}
+	}
+
+	// 失败时不留下半成品的 <file>.part
+	const auto fail_part = [&](const char* what) -> void
+	{
+		const int err = errno;
+		if(!part.empty()) ::unlink(part.c_str());
+		errno = err;
+		fail(what);
+	};
+
+	// 结果区：匿名共享映射或 <file>.part
+	void* base = MAP_FAILED;
+	if(options.file.empty())
+	{
+		base = ::mmap(nullptr, mapped, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+		if(base == MAP_FAILED) fail("mmap");
+	}
+	else
+	{
+		const int fd = ::open(part.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+		if(fd < 0) fail("open");
+		if(::ftruncate(fd, static_cast<off_t>(mapped)) != 0)
+		{
+			const int err = errno;
+			::close(fd);
+			errno = err;
+			fail_part("ftruncate");
+		}
+		base = ::mmap(nullptr, mapped, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+		const int err = errno;
+		::close(fd);
+		errno = err;
+		if(base == MAP_FAILED) fail_part("mmap");
+	}
+	shard_prefix<T> result(base, offset, count, mapped);
+
+	void* page = ::mmap(nullptr, sizeof(shard_details::Control), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+	if(page == MAP_FAILED)
+	{
+		const int err = errno;
+		result = {};
+		errno = err;
+		fail_part("mmap");
+	}
+	auto* ctl = ::new(page) shard_details::Control();
+	T* out = reinterpret_cast<T*>(static_cast<unsigned char*>(base) + offset);
+
+	std::vector<pid_t> children;
+	children.reserve(workers - 1);
+	for(size_t w = 1; w < workers; ++w)
+	{
+		const pid_t pid = ::fork();
+		if(pid == 0)
+		{
+			int status = 0;
+			try
+			{
+				shard_details::drain(*ctl, out, count, workers, grain, term);
+			}
+			catch(...)
+			{
+				status = 1;
+			}
+			::_exit(status);
+		}
+		if(pid < 0) break; // 资源不足时少开几个进程
+		children.push_back(pid);
+	}
+
+	std::exception_ptr error;
+	try
+	{
+		shard_details::drain(*ctl, out, count, workers, grain, term);
+	}
+	catch(...)
+	{
+		error = std::current_exception();
+	}
+
+	bool crashed = false;
+	for(pid_t pid : children)
+	{
+		int status = 0;
+		pid_t waited;
+		while((waited = ::waitpid(pid, &status, 0)) < 0 && errno == EINTR) {}
+		// 等待失败 (如 ECHILD：SIGCHLD 被忽略或子进程已被他人回收) 时无法确认结果，按失败处理
+		if(waited < 0 || !WIFEXITED(status) || WEXITSTATUS(status) != 0) crashed = true;
+	}
+	const bool failed = ctl->failed.load(std::memory_order_relaxed);
+	::munmap(page, sizeof(shard_details::Control));
+
+	if(error || failed || crashed)
+	{
+		result = {};
+		if(!part.empty()) ::unlink(part.c_str());
+		if(error) std::rethrow_exception(error);
+		throw std::runtime_error("hyx::shard_generate: A worker process failed.");
+	}
+
+	if(!part.empty())
+	{
+		// 全部项写完后才写入文件头
+		shard_details::FileHeader header;
+		header.term_size = static_cast<std::uint32_t>(sizeof(T));
+		header.count = count;
+		header.key = options.key;
+		std::memcpy(base, &header, header_bytes);
+		if(std::rename(part.c_str(), options.file.c_str()) != 0)
+		{
+			const int err = errno;
+			result = {};
+			errno = err;
+			fail_part("rename");
+		}
+	}
+	return result;
+#else
+	(void)workers;
+	T* out = static_cast<T*>(::operator new(bytes, std::align_val_t{alignof(T)}));
+	shard_prefix<T> result(out, 0, count, bytes);
+	shard_details::Control ctl;
+	shard_details::drain(ctl, out, count, 1, grain, term);
+	return result;
+#endif
+}
+
+} // namespace hyx
@@ -0,0 +1,442 @@
+#pragma once
+
+#include <version>
+#if __cplusplus < 202302L
+#error "hyx_sketch.hpp requires C++23 or later."
+#endif
+
+/**
+ * @file hyx_sketch.hpp
+ * @brief 数列取值分布的流式摘要：分位数 (KLL)、不同值个数 (HyperLogLog)、高频值 (Space-Saving)
+ * @note 每种摘要的内存与已观察的项数无关，可按块增量更新并随时查询。
+ *       配合 autoseq::set_observer(hyx::sketch_observer(...))，缓存每次扩展时自动更新
+ *
+ * @version 1.0.0
+ * @author Heylyx841
+ * @date 2026-10-18
+ * @license MIT License
+ */
+
+#include <vector>       // std::vector
+#include <span>         // std::span
+#include <functional>   // std::less, std::hash, std::equal_to, std::invoke
+#include <unordered_map> // std::unordered_map
+#include <algorithm>    // std::sort, std::max, std::clamp
+#include <bit>          // std::countl_zero
+#include <cmath>        // std::ceil, std::pow, std::log, std::ldexp
+#include <cstdint>      // std::uint8_t, std::uint64_t
+#include <cstddef>      // size_t
+#include <utility>      // std::move, std::pair, std::swap
+#include <stdexcept>    // std::invalid_argument, std::domain_error
+
+/**
+ * @namespace hyx
+ */
+namespace hyx
+{
+
+/**
+ * @namespace sketch_details
+ * @brief 内部实现细节
+ */
+namespace sketch_details
+{
+
+/** @brief splitmix64 的终结混合，弥补 std::hash 对整数为恒等映射的问题 */
+[[nodiscard]] constexpr std::uint64_t mix(std::uint64_t x) noexcept
+{
+	x ^= x >> 30;
+	x *= 0xBF58476D1CE4E5B9ull;
+	x ^= x >> 27;
+	x *= 0x94D049BB133111EBull;
+	x ^= x >> 31;
+	return x;
+}
+
+} // namespace sketch_details
+
+/**
+ * @class kll_sketch
+ * @brief KLL 分位数摘要 (Karnin-Lang-Liberty)
+ * @note 第 h 层的每个元素代表 2^h 个原始项；某层超出容量时排序并随机保留奇数位或偶数位的一半升入上一层。
+ *       k 控制精度，秩误差约为 1.65 / k (k = 200 时约 0.8%)，保存的元素数为 O(k)。
+ *       随机位由内部的确定性生成器给出，相同输入得到相同结果
+ */
+template <typename T, typename Compare = std::less<T>>
+class kll_sketch
+{
+public:
+	/**
+	 * @throws std::invalid_argument k < 8
+	 */
+	explicit kll_sketch(size_t k = 200, Compare comp = Compare())
+		: k_(k), comp_(std::move(comp))
+	{
+		if(k < 8) [[unlikely]]
+			throw std::invalid_argument("hyx::kll_sketch: k must be at least 8.");
+		levels_.emplace_back();
+		update_capacity();
+	}
+
+	void update(const T& value)
+	{
+		levels_[0].push_back(value);
+		++count_;
+		if(++stored_ > capacity_) compress();
+	}
+
+	void update(std::span<const T> values)
+	{
+		for(const T& v : values)
+			update(v);
+	}
+
+	/** @brief 已观察的项数 */
+	[[nodiscard]] std::uint64_t count() const noexcept
+	{
+		return count_;
+	}
+
+	[[nodiscard]] bool empty() const noexcept
+	{
+		return count_ == 0;
+	}
+
+	/** @brief 摘要中保存的元素数 */
+	[[nodiscard]] size_t retained() const noexcept
+	{
+		return stored_;
+	}
+
+	/**
+	 * @brief 近似 q 分位数，q ∈ [0, 1]
+	 * @throws std::domain_error 摘要为空
+	 */
+	[[nodiscard]] T quantile(double q) const
+	{
+		if(count_ == 0) [[unlikely]]
+			throw std::domain_error("hyx::kll_sketch: Quantile of an empty sketch.");
+		auto items = weighted();
+		const double target = std::clamp(q, 0.0, 1.0) * static_cast<double>(count_);
+		std::uint64_t acc = 0;
+		for(const auto& [value, weight] : items)
+		{
+			acc += weight;
+			if(static_cast<double>(acc) >= target) return value;
+		}
+		return items.back().first;
+	}
+
+	/** @brief 近似秩：小于 value 的项所占比例 */
+	[[nodiscard]] double rank(const T& value) const
+	{
+		if(count_ == 0) return 0;
+		std::uint64_t below = 0;
+		for(size_t h = 0; h < levels_.size(); ++h)
+		{
+			for(const T& v : levels_[h])
+			{
+				if(comp_(v, value)) below += std::uint64_t {1} << h;
+			}
+		}
+		return static_cast<double>(below) / static_cast<double>(count_);
+	}
+
+	/**
+	 * @brief 并入另一个摘要 (k 可以不同，结果沿用本摘要的 k)
+	 */
+	void merge(const kll_sketch& other)
+	{
+		while(levels_.size() < other.levels_.size())
+			levels_.emplace_back();
+		for(size_t h = 0; h < other.levels_.size(); ++h)
+			levels_[h].insert(levels_[h].end(), other.levels_[h].begin(), other.levels_[h].end());
+		count_ += other.count_;
+		stored_ += other.stored_;
+		update_capacity();
+		while(stored_ > capacity_)
+			compress();
+	}
+
+private:
+	size_t k_;
+	[[no_unique_address]] Compare comp_;
+	std::vector<std::vector<T>> levels_;
+	std::uint64_t count_ = 0;
+	size_t stored_ = 0;
+	size_t capacity_ = 0;
+	std::uint64_t rng_ = 0x9E3779B97F4A7C15ull;
+
+	/** @brief 第 h 层容量：k · (2/3)^(H-1-h)，至少为 2 */
+	[[nodiscard]] size_t level_capacity(size_t h) const noexcept
+	{
+		const double depth = static_cast<double>(levels_.size() - 1 - h);
+		return std::max<size_t>(2, static_cast<size_t>(std::ceil(static_cast<double>(k_) * std::pow(2.0 / 3.0, depth))));
+	}
+
+	void update_capacity() noexcept
+	{
+		capacity_ = 0;
+		for(size_t h = 0; h < levels_.size(); ++h)
+			capacity_ += level_capacity(h);
+	}
+
+	[[nodiscard]] bool coin() noexcept
+	{
+		rng_ = sketch_details::mix(rng_ + 0x9E3779B97F4A7C15ull);
+		return rng_ & 1;
+	}
+
+	/** @brief 压缩最低的超容量层 */
+	void compress()
+	{
+		for(size_t h = 0; h < levels_.size(); ++h)
+		{
+			if(levels_[h].size() < level_capacity(h)) continue;
+			if(h + 1 == levels_.size())
+			{
+				levels_.emplace_back();
+				update_capacity();
+			}
+			auto& level = levels_[h];
+			std::sort(level.begin(), level.end(), comp_);
+			// 奇数个时保留第一个在本层，其余成对压缩
+			const size_t keep = level.size() & 1;
+			const size_t offset = keep + (coin() ? 1 : 0);
+			auto& up = levels_[h + 1];
+			for(size_t i = offset; i < level.size(); i += 2)
+				up.push_back(std::move(level[i]));
+			const size_t promoted = (level.size() - keep) / 2;
+			level.resize(keep);
+			stored_ -= promoted;
+			return;
+		}
+	}
+
+	/** @brief 按值排序的 (元素, 权重) 序列 */
+	[[nodiscard]] std::vector<std::pair<T, std::uint64_t>> weighted() const
+	{
+		std::vector<std::pair<T, std::uint64_t>> items;
+		items.reserve(stored_);
+		for(size_t h = 0; h < levels_.size(); ++h)
+		{
+			for(const T& v : levels_[h])
+				items.emplace_back(v, std::uint64_t {1} << h);
+		}
+		std::sort(items.begin(), items.end(), [this](const auto& a, const auto& b) { return comp_(a.first, b.first); });
+		return items;
+	}
+};
+
+/**
+ * @class hyperloglog
+ * @brief HyperLogLog 不同值个数估计
+ * @note 2^precision 个 6 位寄存器 (按字节存放)，相对标准误差约 1.04 / sqrt(2^precision)；
+ *       precision = 12 时为 4 KiB、约 1.6%。小基数时使用线性计数修正
+ */
+template <typename T, typename Hash = std::hash<T>>
+class hyperloglog
+{
+public:
+	/**
+	 * @throws std::invalid_argument precision 不在 [4, 18] 内
+	 */
+	explicit hyperloglog(unsigned precision = 12, Hash hash = Hash())
+		: precision_(precision), hash_(std::move(hash))
+	{
+		if(precision < 4 || precision > 18) [[unlikely]]
+			throw std::invalid_argument("hyx::hyperloglog: Precision must be in [4, 18].");
+		registers_.assign(size_t {1} << precision, 0);
+	}
+
+	void update(const T& value)
+	{
+		const std::uint64_t h = sketch_details::mix(static_cast<std::uint64_t>(std::invoke(hash_, value)));
+		const size_t index = static_cast<size_t>(h >> (64 - precision_));
+		const std::uint64_t rest = (h << precision_) | (std::uint64_t {1} << (precision_ - 1));
+		const auto rho = static_cast<std::uint8_t>(std::countl_zero(rest) + 1);
+		registers_[index] = std::max(registers_[index], rho);
+	}
+
+	void update(std::span<const T> values)
+	{
+		for(const T& v : values)
+			update(v);
+	}
+
+	/** @brief 估计的不同值个数 */
+	[[nodiscard]] double estimate() const noexcept
+	{
+		const double m = static_cast<double>(registers_.size());
+		double sum = 0;
+		size_t zeros = 0;
+		for(std::uint8_t r : registers_)
+		{
+			sum += std::ldexp(1.0, -r);
+			zeros += r == 0;
+		}
+		const double alpha = 0.7213 / (1 + 1.079 / m);
+		const double raw = alpha * m * m / sum;
+		if(raw <= 2.5 * m && zeros > 0)
+			return m * std::log(m / static_cast<double>(zeros));
+		return raw;
+	}
+
+	/**
+	 * @brief 并入另一个摘要
+	 * @throws std::invalid_argument 精度不同
+	 */
+	void merge(const hyperloglog& other)
+	{
+		if(other.precision_ != precision_) [[unlikely]]
+			throw std::invalid_argument("hyx::hyperloglog: Cannot merge sketches of different precision.");
+		for(size_t i = 0; i < registers_.size(); ++i)
+			registers_[i] = std::max(registers_[i], other.registers_[i]);
+	}
+
+private:
+	unsigned precision_;
+	[[no_unique_address]] Hash hash_;
+	std::vector<std::uint8_t> registers_;
+};
+
+/**
+ * @class space_saving
+ * @brief Space-Saving 高频值统计 (Metwally 等)
+ * @note 只跟踪 capacity 个候选值，计数保存在按计数排列的小顶堆中，每次更新 O(log capacity)。
+ *       对任意候选 count - error <= 真实频数 <= count；真实频数超过 总数 / capacity 的值一定在候选中
+ */
+template <typename T, typename Hash = std::hash<T>, typename KeyEqual = std::equal_to<T>>
+class space_saving
+{
+public:
+	struct entry
+	{
+		T value;
+		std::uint64_t count;
+		/** @brief 计数的高估上限 */
+		std::uint64_t error;
+	};
+
+	/**
+	 * @throws std::invalid_argument capacity == 0
+	 */
+	explicit space_saving(size_t capacity = 64)
+		: capacity_(capacity)
+	{
+		if(capacity == 0) [[unlikely]]
+			throw std::invalid_argument("hyx::space_saving: Capacity must be positive.");
+		heap_.reserve(capacity);
+		slot_.reserve(capacity);
+	}
+
+	void update(const T& value)
+	{
+		++total_;
+		if(auto it = slot_.find(value); it != slot_.end())
+		{
+			++heap_[it->second].count;
+			sift_down(it->second);
+			return;
+		}
+		if(heap_.size() < capacity_)
+		{
+			heap_.push_back({value, 1, 0});
+			slot_.emplace(value, heap_.size() - 1);
+			sift_up(heap_.size() - 1);
+			return;
+		}
+		// 替换计数最小的候选，新值继承其计数作为误差上限
+		auto& root = heap_[0];
+		slot_.erase(root.value);
+		root.error = root.count;
+		++root.count;
+		root.value = value;
+		slot_.emplace(value, 0);
+		sift_down(0);
+	}
+
+	void update(std::span<const T> values)
+	{
+		for(const T& v : values)
+			update(v);
+	}
+
+	/** @brief 已观察的项数 */
+	[[nodiscard]] std::uint64_t count() const noexcept
+	{
+		return total_;
+	}
+
+	/**
+	 * @brief 计数最高的至多 n 个候选，按计数降序
+	 */
+	[[nodiscard]] std::vector<entry> top(size_t n = static_cast<size_t>(-1)) const
+	{
+		std::vector<entry> out(heap_.begin(), heap_.end());
+		std::sort(out.begin(), out.end(), [](const entry& a, const entry& b) { return a.count > b.count; });
+		if(out.size() > n) out.resize(n);
+		return out;
+	}
+
+	/** @brief value 的计数上限，不在候选中时为当前最小计数 (或 0) */
+	[[nodiscard]] std::uint64_t estimate(const T& value) const
+	{
+		if(auto it = slot_.find(value); it != slot_.end()) return heap_[it->second].count;
+		return heap_.size() < capacity_ ? 0 : heap_[0].count;
+	}
+
+private:
+	size_t capacity_;
+	std::vector<entry> heap_;
+	std::unordered_map<T, size_t, Hash, KeyEqual> slot_;
+	std::uint64_t total_ = 0;
+
+	void swap_nodes(size_t a, size_t b)
+	{
+		std::swap(heap_[a], heap_[b]);
+		slot_.find(heap_[a].value)->second = a;
+		slot_.find(heap_[b].value)->second = b;
+	}
+
+	void sift_up(size_t i)
+	{
+		while(i > 0)
+		{
+			const size_t parent = (i - 1) / 2;
+			if(heap_[parent].count <= heap_[i].count) break;
+			swap_nodes(i, parent);
+			i = parent;
+		}
+	}
+
+	void sift_down(size_t i)
+	{
+		while(true)
+		{
+			size_t least = i;
+			for(size_t c = 2 * i + 1; c <= 2 * i + 2 && c < heap_.size(); ++c)
+			{
+				if(heap_[c].count < heap_[least].count) least = c;
+			}
+			if(least == i) return;
+			swap_nodes(i, least);
+			i = least;
+		}
+	}
+};
+
+/**
+ * @brief 把若干摘要打包成 autoseq 的追加观察者
+ * @note 摘要以引用保存，必须比观察者活得更久
+ */
+template <typename... Sketches>
+[[nodiscard]] auto sketch_observer(Sketches&... sketches)
+{
+	return [&sketches...]<typename T>(size_t, std::span<const T> terms)
+	{
+		(sketches.update(terms), ...);
+	};
+}
+
+} // namespace hyx
@@ -0,0 +1,411 @@
+#pragma once
+
+#include <version>
+#if __cplusplus < 202302L
+#error "hyx_soa.hpp requires C++23 or later."
+#endif
+
+/**
+ * @file hyx_soa.hpp
+ * @brief 元组式元素 (std::pair, std::tuple, 实现了 tuple 协议的结构体) 的列式 (SoA) 数列
+ * @note 每个成员单独存放在一列连续内存中，column<I>() 直接给出 std::span，便于 SIMD 批量处理；
+ *       公式仍按整项书写：上下文 F[i] 由各列重新组装出 T
+ *
+ * @version 1.0.0
+ * @author Heylyx841
+ * @date 2026-10-18
+ * @license MIT License
+ */
+
+#include <vector>       // std::vector
+#include <span>         // std::span
+#include <tuple>        // std::tuple, std::tuple_size, std::tuple_element, std::get, std::apply
+#include <memory>       // std::allocator, std::allocator_traits
+#include <functional>   // std::move_only_function, std::invoke
+#include <utility>      // std::index_sequence, std::make_index_sequence, std::forward, std::as_const
+#include <concepts>     // std::convertible_to
+#include <type_traits>  // std::is_constructible_v, std::remove_cvref_t, std::is_invocable_r_v, std::is_same_v
+#include <cstddef>      // size_t
+#include <cassert>      // assert
+#include <stdexcept>    // std::out_of_range, std::invalid_argument
+
+/**
+ * @namespace hyx
+ */
+namespace hyx
+{
+
+/**
+ * @namespace soa_details
+ * @brief 内部实现细节
+ */
+namespace soa_details
+{
+
+template <typename T>
+concept tuple_like = requires { std::tuple_size<T>::value; } && std::tuple_size_v<T> > 0;
+
+/** @brief 按 tuple 协议取第 I 个成员：优先成员函数 get，其次 ADL get */
+template <size_t I, typename T>
+decltype(auto) member(T&& t)
+{
+	if constexpr(requires { std::forward<T>(t).template get<I>(); })
+	{
+		return std::forward<T>(t).template get<I>();
+	}
+	else
+	{
+		using std::get;
+		return get<I>(std::forward<T>(t));
+	}
+}
+
+template <typename T, size_t I>
+using member_t = std::remove_cvref_t<std::tuple_element_t<I, T>>;
+
+template <typename T, typename Alloc, typename Seq = std::make_index_sequence<std::tuple_size_v<T>>>
+struct Columns;
+
+/** @brief 每个成员一列 */
+template <typename T, typename Alloc, size_t... I>
+struct Columns<T, Alloc, std::index_sequence<I...>>
+{
+	static_assert((!std::is_same_v<member_t<T, I>, bool> && ...),
+	              "hyx::soa_autoseq: bool members are not supported (std::vector<bool> is not contiguous); use std::uint8_t or a byte-sized enum.");
+
+	using type = std::tuple<std::vector<member_t<T, I>, typename std::allocator_traits<Alloc>::template rebind_alloc<member_t<T, I>>>...>;
+	using views = std::tuple<std::span<const member_t<T, I>>...>;
+};
+
+/** @brief 由各成员重新组装 T：可直接构造时用圆括号，否则按聚合初始化 */
+template <typename T, typename... Args>
+T assemble(Args&&... args)
+{
+	if constexpr(std::is_constructible_v<T, Args&&...>)
+		return T(std::forward<Args>(args)...);
+	else
+		return T {std::forward<Args>(args)...};
+}
+
+} // namespace soa_details
+
+/**
+ * @class soa_view
+ * @brief 连续若干项的列式只读视图
+ */
+template <typename T>
+requires soa_details::tuple_like<T>
+class soa_view
+{
+public:
+	static constexpr size_t columns = std::tuple_size_v<T>;
+	using column_views = typename soa_details::Columns<T, std::allocator<T>>::views;
+
+	soa_view() noexcept = default;
+
+	soa_view(column_views cols, size_t count) noexcept
+		: cols_(cols), count_(count)
+	{
+	}
+
+	/** @brief 第 I 列 */
+	template <size_t I>
+	[[nodiscard]] std::span<const soa_details::member_t<T, I>> column() const noexcept
+	{
+		return std::get<I>(cols_);
+	}
+
+	/** @brief 组装第 i 项 */
+	[[nodiscard]] T operator[](size_t i) const
+	{
+		assert(i < count_ && "hyx::soa_view: Index out of range.");
+		return [&]<size_t... I>(std::index_sequence<I...>)
+		{
+			return soa_details::assemble<T>(std::get<I>(cols_)[i]...);
+		}(std::make_index_sequence<columns>());
+	}
+
+	[[nodiscard]] size_t size() const noexcept
+	{
+		return count_;
+	}
+
+	[[nodiscard]] bool empty() const noexcept
+	{
+		return count_ == 0;
+	}
+
+	/** @brief [first, first + count) 项的子视图 */
+	[[nodiscard]] soa_view subview(size_t first, size_t count) const noexcept
+	{
+		assert(first + count <= count_ && "hyx::soa_view: Subview out of range.");
+		return [&]<size_t... I>(std::index_sequence<I...>)
+		{
+			return soa_view(column_views(std::get<I>(cols_).subspan(first, count)...), count);
+		}(std::make_index_sequence<columns>());
+	}
+
+private:
+	column_views cols_ {};
+	size_t count_ = 0;
+};
+
+namespace soa_details
+{
+
+/**
+ * @struct SoaContext
+ * @brief 数学公式执行上下文，F[i] 组装第 i 项，F.column<I>() 给出历史的第 I 列
+ */
+template <typename T>
+struct SoaContext
+{
+	/** @brief 当前正在计算的项索引 n */
+	size_t index_val;
+	/** @brief 已计算的第 [0, n) 项 */
+	soa_view<T> history;
+
+	[[nodiscard]] size_t n() const noexcept
+	{
+		return index_val;
+	}
+
+	[[nodiscard]] T last() const
+	{
+		assert(!history.empty() && "hyx::soa_autoseq: Cannot access last() on empty sequence.");
+		return history[history.size() - 1];
+	}
+
+	[[nodiscard]] T operator[](size_t i) const
+	{
+		return history[i];
+	}
+
+	template <size_t I>
+	[[nodiscard]] std::span<const member_t<T, I>> column() const noexcept
+	{
+		return history.template column<I>();
+	}
+};
+
+template <typename T>
+using SoaFormula = std::move_only_function<T(size_t, soa_view<T>)>;
+
+/**
+ * @brief 智能签名适配
+ */
+template <typename T, typename F>
+SoaFormula<T> make_soa_dispatch(F&& f)
+{
+	using Context = SoaContext<T>;
+
+	// 模式 A: 原始模式 T(size_t n, soa_view history)
+	if constexpr(std::is_invocable_r_v<T, F, size_t, soa_view<T>>)
+	{
+		return [f = std::forward<F>(f)](size_t n, soa_view<T> h) mutable -> T
+		{
+			return static_cast<T>(std::invoke(f, n, h));
+		};
+	}
+	// 模式 B: 数学上下文模式 T(context)
+	else if constexpr(std::is_invocable_r_v<T, F, Context>)
+	{
+		return [f = std::forward<F>(f)](size_t n, soa_view<T> h) mutable -> T
+		{
+			return static_cast<T>(std::invoke(f, Context {n, h}));
+		};
+	}
+	else
+	{
+		static_assert(false, "hyx::soa_autoseq: Unrecognized formula signature. Expected T(size_t, soa_view) or T(context).");
+	}
+}
+
+} // namespace soa_details
+
+/**
+ * @class soa_autoseq
+ * @brief 按列存储的惰性数列
+ * @note operator[] 按值返回组装后的项；column<I>() 的 span 在之后扩展数列时可能失效，与 std::vector 的迭代器相同
+ *
+ * @tparam T 元组式类型：提供 std::tuple_size / std::tuple_element 与 get<I>，且可由各成员构造或聚合初始化；
+ *           成员不能是 bool (std::vector<bool> 无法给出 span)，请改用 std::uint8_t
+ * @tparam Alloc 分配器，按成员类型 rebind 后用于各列
+ */
+template <typename T, typename Alloc = std::allocator<T>>
+requires soa_details::tuple_like<T>
+class soa_autoseq
+{
+public:
+	using value_type = T;
+	using allocator_type = Alloc;
+	using context = soa_details::SoaContext<T>;
+	static constexpr size_t columns = std::tuple_size_v<T>;
+
+private:
+	using Indices = std::make_index_sequence<columns>;
+
+	mutable typename soa_details::Columns<T, Alloc>::type cols_;
+	mutable soa_details::SoaFormula<T> formula_;
+
+	/** @brief 拆开 t 追加到各列；任一列失败时回滚已追加的列 */
+	template <typename V>
+	void append(V&& t) const
+	{
+		const size_t n = size();
+		[&]<size_t... I>(std::index_sequence<I...>)
+		{
+			try
+			{
+				(std::get<I>(cols_).push_back(soa_details::member<I>(std::forward<V>(t))), ...);
+			}
+			catch(...)
+			{
+				((std::get<I>(cols_).size() > n ? std::get<I>(cols_).pop_back() : void()), ...);
+				throw;
+			}
+		}(Indices());
+	}
+
+	void ensure_calculated(size_t target_index) const
+	{
+		while(size() <= target_index)
+		{
+			const size_t n = size();
+			append(formula_(n, view()));
+		}
+	}
+
+public:
+	/**
+	 * @brief 构造函数
+	 */
+	template <typename Gen, typename... InitArgs>
+	requires(std::convertible_to<InitArgs, T> && ...)
+	explicit soa_autoseq(Gen&& g, InitArgs&&... init_values)
+		: soa_autoseq(std::allocator_arg, Alloc(), std::forward<Gen>(g), std::forward<InitArgs>(init_values)...)
+	{
+	}
+
+	/**
+	 * @brief 使用指定分配器的构造函数
+	 */
+	template <typename Gen, typename... InitArgs>
+	requires(std::convertible_to<InitArgs, T> && ...)
+	soa_autoseq(std::allocator_arg_t, const Alloc& alloc, Gen&& g, InitArgs&&... init_values)
+		: cols_([&]<size_t... I>(std::index_sequence<I...>)
+		  {
+			  return typename soa_details::Columns<T, Alloc>::type(
+				  typename std::tuple_element_t<I, typename soa_details::Columns<T, Alloc>::type>::allocator_type(alloc)...);
+		  }(Indices()))
+		, formula_(soa_details::make_soa_dispatch<T>(std::forward<Gen>(g)))
+	{
+		(append(static_cast<T>(std::forward<InitArgs>(init_values))), ...);
+	}
+
+	soa_autoseq(const soa_autoseq&) = delete;
+	soa_autoseq& operator=(const soa_autoseq&) = delete;
+
+	soa_autoseq(soa_autoseq&&) noexcept = default;
+	soa_autoseq& operator=(soa_autoseq&&) noexcept = default;
+
+	/**
+	 * @brief 组装第 n 项
+	 */
+	[[nodiscard]] T operator[](size_t n) const
+	{
+		ensure_calculated(n);
+		return view()[n];
+	}
+
+	/**
+	 * @brief 带边界检查组装第 n 项
+	 */
+	[[nodiscard]] T at(size_t n) const
+	{
+		if(n >= std::get<0>(cols_).max_size()) [[unlikely]]
+			throw std::out_of_range("hyx::soa_autoseq: Index exceeds maximum container size.");
+		return (*this)[n];
+	}
+
+	/**
+	 * @brief 第 n 项的第 I 个成员，不组装整项
+	 */
+	template <size_t I>
+	[[nodiscard]] const soa_details::member_t<T, I>& get(size_t n) const
+	{
+		ensure_calculated(n);
+		return std::get<I>(cols_)[n];
+	}
+
+	/**
+	 * @brief 已缓存部分的第 I 列
+	 */
+	template <size_t I>
+	[[nodiscard]] std::span<const soa_details::member_t<T, I>> column() const noexcept
+	{
+		return std::get<I>(cols_);
+	}
+
+	/**
+	 * @brief 缓存数列到第 n 项
+	 */
+	void prefetch_up_to(size_t n) const
+	{
+		ensure_calculated(n);
+	}
+
+	/**
+	 * @brief 丢弃第 n 项及之后的缓存，之后访问时重新计算
+	 */
+	void trim(size_t n) const
+	{
+		if(n >= size()) return;
+		std::apply([n](auto&... col) { (col.resize(n), ...); }, cols_);
+	}
+
+	/**
+	 * @brief 预分配各列容量
+	 */
+	void reserve(size_t n) const
+	{
+		std::apply([n](auto&... col) { (col.reserve(n), ...); }, cols_);
+	}
+
+	/**
+	 * @brief 多下标切片访问 [start, end)
+	 */
+	[[nodiscard]] soa_view<T> slice(size_t start, size_t end) const
+	{
+		if(start > end) [[unlikely]]
+			throw std::invalid_argument("hyx::soa_autoseq: Invalid slice range (start > end).");
+		if(start == end) return {};
+		ensure_calculated(end - 1);
+		return view().subview(start, end - start);
+	}
+
+	/**
+	 * @brief 获取当前已缓存数据的列式视图
+	 */
+	[[nodiscard]] soa_view<T> view() const noexcept
+	{
+		return [&]<size_t... I>(std::index_sequence<I...>)
+		{
+			return soa_view<T>(typename soa_view<T>::column_views(std::span(std::as_const(std::get<I>(cols_)))...), size());
+		}(Indices());
+	}
+
+	/** @brief 获取当前已缓存的数据项总数 */
+	[[nodiscard]] size_t size() const noexcept
+	{
+		return std::get<0>(cols_).size();
+	}
+
+	/** @brief 获取分配器 */
+	[[nodiscard]] Alloc get_allocator() const noexcept
+	{
+		return Alloc(std::get<0>(cols_).get_allocator());
+	}
+};
+
+} // namespace hyx